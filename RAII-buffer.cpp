@@ -1,86 +1,7 @@
 #include <iostream>
-#include <stdexcept>
 #include <vector>
-#include <utility>
 
-template <typename T>
-class RAIIBuffer
-{
-private:
-    T *data_;
-    size_t size_;
-
-public:
-    // Constructor
-    explicit RAIIBuffer(size_t n) : size_(n), data_(new T[n]) {}
-
-    RAIIBuffer(std::initializer_list<T> list) : size_(list.size()), data_(new T[list.size()])
-    {
-        std::copy(list.begin(), list.end(), data_);
-    }
-
-    // Destructor
-    ~RAIIBuffer()
-    {
-        delete[] this->data_;
-        this->size_ = 0;
-    }
-
-    // Delete copy constructor and copy assignment
-    // Useful for avoiding double delete, because it performs only shallow copies
-    RAIIBuffer(const RAIIBuffer &buf) = delete;
-    RAIIBuffer &operator=(const RAIIBuffer &buf) = delete;
-
-    // Move constructor
-    // This will allow us to, for instance, return buffers safely from functions
-    // It is not necessary to do: data_(std::move(other.data_)) or size_(std::move(other.size_))
-    // Because the first one is a pointer and the second is a primitive
-    // These are variables with few semantics, therefore std::move will do nothing
-    RAIIBuffer(RAIIBuffer &&other) noexcept : data_(other.data_), size_(other.size_)
-    {
-        other.data_ = nullptr;
-        other.size_ = 0;
-    }
-
-    // Move Assignement (Rule of Five is complete)
-    RAIIBuffer &operator=(RAIIBuffer &&other) noexcept
-    {
-        if (this == &other)
-            return *this;
-        delete[] this->data_;
-        this->data_ = other.data_;
-        this->size_ = other.size_;
-        other.data_ = nullptr;
-        other.size_ = 0;
-        return *this;
-    }
-
-    // Access operator
-    T &operator[](size_t index)
-    {
-        if (index >= this->size_)
-            throw std::out_of_range("Index out of range\n");
-        return this->data_[index];
-    }
-
-    const T &operator[](size_t index) const
-    {
-        if (index >= this->size_)
-            throw std::out_of_range("Index out of range\n");
-        return this->data_[index];
-    }
-
-    // Size getter
-    size_t size() const { return this->size_; }
-};
-
-template <typename T, typename... Args>
-RAIIBuffer<T> make_buffer(Args &&...args)
-{
-    // TODO: Create and return RAIIBuffer<T>, forwarding all arguments
-    // Hint: RAIIBuffer<T>(std::forward<Args>(args)...)
-    return RAIIBuffer<T>(std::forward<Args>(args)...);
-}
+#include "RAII-buffer.hpp"
 
 int main()
 {
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <execution>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <unistd.h>
+
+#include "algorithms.hpp"
+#include "benchmark.hpp"
+#include "thread-pool.hpp"
+
+// square_vector / sum_vector / filter_great: the original single-threaded templates against the
+// execution policy overloads (seq, unseq, par, par_unseq) and the thread pool overloads on
+// 1, 2, 4, ... threads, from 1M elements up to --max-size (default 1G), skipping sizes that
+// do not fit in memory. filter_great keeps half of the elements.
+// Usage: ./algorithms-parallel [--max-size N] [--json file] [--filter name] [--samples n]
+//   par / par_unseq run on the standard library's backend when it has one (TBB with libstdc++),
+//   on parallel::default_pool() otherwise; build with -ltbb when the TBB headers are installed
+
+bool report(const std::string &what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+std::vector<unsigned> thread_counts()
+{
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < hardware; t *= 2)
+        counts.push_back(t);
+    counts.push_back(hardware);
+    return counts;
+}
+
+// Values in {-1, 0, 1, 2}: sums of up to 1G elements and of their squares fit in an int
+std::vector<int> make_values(std::size_t n)
+{
+    std::vector<int> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+        v[i] = static_cast<int>(i % 4) - 1;
+    return v;
+}
+
+// Every overload gives the result of the original template, also when appending to a non-empty vector
+template <typename Square, typename Sum, typename Filter>
+bool verify(const std::string &what, Square square, Sum sum, Filter filter)
+{
+    const std::vector<int> values = make_values((1 << 20) + 123);
+    std::vector<int> squared = values, expected_squared = values;
+    square(squared);
+    square_vector(expected_squared);
+    std::vector<int> filtered{7, 7}, expected_filtered{7, 7};
+    filter(values, filtered);
+    filter_great(values, expected_filtered, 0);
+    return report(what, squared == expected_squared && sum(values) == sum_vector(values) && filtered == expected_filtered);
+}
+
+template <typename Square, typename Sum, typename Filter>
+void benchmark(bench::Runner &runner, const std::string &what, std::vector<int> &values, std::vector<int> &bits,
+               Square square, Sum sum, Filter filter)
+{
+    const double bytes = double(values.size()) * sizeof(int);
+    const std::string n = " n=" + std::to_string(values.size());
+    runner.run(
+        "square_vector " + what + n, [&]()
+        { square(bits); bench::ClobberMemory(); },
+        2 * bytes);
+    runner.run(
+        "sum_vector " + what + n, [&]()
+        { bench::DoNotOptimize(sum(values)); },
+        bytes);
+    // A new output vector every time, as the reallocations of back_inserter are part of the cost
+    runner.run(
+        "filter_great " + what + n, [&]()
+        {
+            std::vector<int> out;
+            filter(values, out);
+            bench::DoNotOptimize(out.data()); },
+        1.5 * bytes);
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t max_size = std::size_t(1) << 30;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--max-size")
+            max_size = std::strtoull(argv[i + 1], nullptr, 10);
+    std::cout << "standard library parallel backend: " << (ALGORITHMS_STD_PARALLEL ? "yes" : "no, par runs on the thread pool")
+              << ", hardware threads " << std::thread::hardware_concurrency() << "\n";
+
+    namespace ex = std::execution;
+    const auto policy_overloads = [](auto policy)
+    {
+        return std::make_tuple([policy](std::vector<int> &v)
+                               { square_vector(policy, v); },
+                               [policy](const std::vector<int> &v)
+                               { return sum_vector(policy, v); },
+                               [policy](const std::vector<int> &v, std::vector<int> &out)
+                               { filter_great(policy, v, out, 0); });
+    };
+    const auto pool_overloads = [](parallel::ThreadPool &pool)
+    {
+        return std::make_tuple([&pool](std::vector<int> &v)
+                               { square_vector(pool, v); },
+                               [&pool](const std::vector<int> &v)
+                               { return sum_vector(pool, v); },
+                               [&pool](const std::vector<int> &v, std::vector<int> &out)
+                               { filter_great(pool, v, out, 0); });
+    };
+    const auto original = std::make_tuple([](std::vector<int> &v)
+                                          { square_vector(v); },
+                                          [](const std::vector<int> &v)
+                                          { return sum_vector(v); },
+                                          [](const std::vector<int> &v, std::vector<int> &out)
+                                          { filter_great(v, out, 0); });
+
+    std::cout << "\n=== Verification against the original templates ===\n";
+    bool ok = true;
+    const auto check = [&](const std::string &what, auto overloads)
+    { ok &= std::apply([&](auto... f)
+                       { return verify(what, f...); },
+                       overloads); };
+    check("seq", policy_overloads(ex::seq));
+    check("unseq", policy_overloads(ex::unseq));
+    check("par", policy_overloads(ex::par));
+    check("par_unseq", policy_overloads(ex::par_unseq));
+    for (unsigned threads : thread_counts())
+    {
+        parallel::ThreadPool pool(threads);
+        check("thread pool, " + std::to_string(threads) + " threads", pool_overloads(pool));
+    }
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const std::size_t memory = std::size_t(sysconf(_SC_PHYS_PAGES)) * std::size_t(sysconf(_SC_PAGESIZE));
+    for (std::size_t n = std::size_t(1) << 20; n <= max_size; n <<= 3)
+    {
+        // values, bits and the filter output (half of values), with some headroom
+        if (3 * n * sizeof(int) > memory / 10 * 8)
+        {
+            std::cout << "n=" << n << " skipped, needs more than 80% of the " << (memory >> 20) << " MiB of memory\n";
+            break;
+        }
+        std::vector<int> values = make_values(n), bits(n);
+        for (std::size_t i = 0; i < n; ++i)
+            bits[i] = static_cast<int>(i & 1); // squaring keeps 0 and 1, so repeated runs do not overflow
+        const auto run = [&](const std::string &what, auto overloads)
+        { std::apply([&](auto... f)
+                     { benchmark(runner, what, values, bits, f...); },
+                     overloads); };
+        run("original", original);
+        run("seq", policy_overloads(ex::seq));
+        run("unseq", policy_overloads(ex::unseq));
+        run("par", policy_overloads(ex::par));
+        run("par_unseq", policy_overloads(ex::par_unseq));
+        for (unsigned threads : thread_counts())
+        {
+            parallel::ThreadPool pool(threads);
+            run("pool T=" + std::to_string(threads), pool_overloads(pool));
+        }
+        if (n < max_size && n << 3 > max_size)
+            n = max_size >> 3; // always end with max_size itself
+    }
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -1,40 +1,9 @@
 #include <iostream>
 #include <vector>
 #include <numeric>
-#include <algorithm>
-#include <concepts>
-#include <type_traits>
 
-template <typename T>
-concept arithmetic = std::is_arithmetic_v<T>;
-
-template <arithmetic T>
-void print_vector(const std::vector<T> &v)
-{
-    std::for_each(v.begin(), v.end(), [](T x)
-                  { std::cout << x << " "; });
-    std::cout << "\n";
-};
-
-template <arithmetic T>
-void square_vector(std::vector<T> &v)
-{
-    std::transform(v.begin(), v.end(), v.begin(), [](T x)
-                   { return x * x; });
-};
-
-template <arithmetic T>
-void filter_great(const std::vector<T> &v, std::vector<T> &v_copy, T a)
-{
-    copy_if(v.begin(), v.end(), std::back_inserter(v_copy), [a](T x)
-            { return x > a; });
-};
-
-template <arithmetic T>
-T sum_vector(const std::vector<T> &v)
-{
-    return std::accumulate(v.begin(), v.end(), T{0});
-};
+#include "algorithms.hpp"
+#include "pipeline.hpp"
 
 int main()
 {
@@ -57,5 +26,12 @@ int main()
 
     print_vector(l_copy);
 
+    // The same without squaring in place or intermediate vectors: one pass over the values
+    std::vector<int> m(10);
+    std::iota(m.begin(), m.end(), 1);
+    auto squares_over_30 = pipes::pipeline(m).map(pipes::square).filter(pipes::gt(30));
+    std::cout << "Sum of squares greater than 30: " << squares_over_30.reduce(pipes::sum) << "\n";
+    print_vector(squares_over_30.to_vector());
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "thread-pool.hpp"
+
+// Whether the standard library runs par / par_unseq algorithms on several threads: libstdc++
+// does with TBB (link -ltbb), MSVC always. Elsewhere (libstdc++ serial backend, libc++) the
+// execution policy overloads below run them on parallel::default_pool() instead.
+#if defined(_PSTL_PAR_BACKEND_TBB) || defined(_MSC_VER)
+#define ALGORITHMS_STD_PARALLEL 1
+#else
+#define ALGORITHMS_STD_PARALLEL 0
+#endif
+
+template <typename T>
+concept arithmetic = std::is_arithmetic_v<T>;
+
+template <arithmetic T>
+void print_vector(const std::vector<T> &v)
+{
+    std::for_each(v.begin(), v.end(), [](T x)
+                  { std::cout << x << " "; });
+    std::cout << "\n";
+};
+
+template <arithmetic T>
+void square_vector(std::vector<T> &v)
+{
+    std::transform(v.begin(), v.end(), v.begin(), [](T x)
+                   { return x * x; });
+};
+
+template <arithmetic T>
+void filter_great(const std::vector<T> &v, std::vector<T> &v_copy, T a)
+{
+    copy_if(v.begin(), v.end(), std::back_inserter(v_copy), [a](T x)
+            { return x > a; });
+};
+
+template <arithmetic T>
+T sum_vector(const std::vector<T> &v)
+{
+    return std::accumulate(v.begin(), v.end(), T{0});
+};
+
+template <typename Policy>
+concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<Policy>>;
+
+// par and par_unseq
+template <typename Policy>
+inline constexpr bool is_parallel_policy = std::is_same_v<std::remove_cvref_t<Policy>, std::execution::parallel_policy> ||
+                                           std::is_same_v<std::remove_cvref_t<Policy>, std::execution::parallel_unsequenced_policy>;
+
+// unseq and par_unseq
+template <typename Policy>
+inline constexpr bool is_vector_policy = std::is_same_v<std::remove_cvref_t<Policy>, std::execution::unsequenced_policy> ||
+                                         std::is_same_v<std::remove_cvref_t<Policy>, std::execution::parallel_unsequenced_policy>;
+
+// Policy for the share of one pool thread: vectorized unless the policy forbids it
+// (an lvalue, as libstdc++ does not accept temporaries as policies)
+template <typename Policy>
+inline constexpr auto thread_policy = [] {
+    if constexpr (is_vector_policy<Policy>)
+        return std::execution::unseq;
+    else
+        return std::execution::seq;
+}();
+
+// Whether a policy overload goes to the thread pool rather than to the standard library
+template <typename Policy>
+inline constexpr bool runs_on_pool = is_parallel_policy<Policy> && !ALGORITHMS_STD_PARALLEL;
+
+// The same algorithms on a parallel::ThreadPool, each thread taking a contiguous share;
+// Policy is the policy of one thread's share (seq or unseq)
+template <typename Policy = std::execution::unsequenced_policy, arithmetic T>
+void square_vector(parallel::ThreadPool &pool, std::vector<T> &v)
+{
+    pool.for_ranges(v.size(), [&](unsigned, std::size_t begin, std::size_t end)
+                    { std::transform(thread_policy<Policy>, v.begin() + begin, v.begin() + end, v.begin() + begin, [](T x)
+                                     { return x * x; }); });
+};
+
+// Partial sums per thread, added in thread order (the result does not depend on timing)
+template <typename Policy = std::execution::unsequenced_policy, arithmetic T>
+T sum_vector(parallel::ThreadPool &pool, const std::vector<T> &v)
+{
+    struct alignas(64) Partial
+    {
+        T value{0};
+    };
+    std::vector<Partial> partials(pool.size());
+    pool.for_ranges(v.size(), [&](unsigned part, std::size_t begin, std::size_t end)
+                    { partials[part].value = std::reduce(thread_policy<Policy>, v.begin() + begin, v.begin() + end, T{0}); });
+    T sum{0};
+    for (const Partial &p : partials)
+        sum += p.value;
+    return sum;
+};
+
+// Two passes: every thread counts the matches in its share, an exclusive prefix sum of the
+// counts gives each thread its output offset, then every thread copies its matches there.
+// v_copy is resized once (appending, like the back_inserter version) instead of growing.
+template <typename Policy = std::execution::unsequenced_policy, arithmetic T>
+void filter_great(parallel::ThreadPool &pool, const std::vector<T> &v, std::vector<T> &v_copy, T a)
+{
+    const auto greater = [a](T x)
+    { return x > a; };
+    std::vector<std::size_t> offsets(pool.parts_for(v.size(), std::size_t(1) << 14) + 1, 0);
+    pool.for_ranges(v.size(), [&](unsigned part, std::size_t begin, std::size_t end)
+                    { offsets[part + 1] = std::count_if(thread_policy<Policy>, v.begin() + begin, v.begin() + end, greater); });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    const std::size_t first = v_copy.size();
+    v_copy.resize(first + offsets.back());
+    pool.for_ranges(v.size(), [&](unsigned part, std::size_t begin, std::size_t end)
+                    { std::copy_if(thread_policy<Policy>, v.begin() + begin, v.begin() + end, v_copy.begin() + first + offsets[part], greater); });
+};
+
+// Execution policy overloads: seq, unseq, par, par_unseq
+// par / par_unseq use the standard library's parallel algorithms when it has a parallel
+// backend (ALGORITHMS_STD_PARALLEL), parallel::default_pool() otherwise
+template <execution_policy Policy, arithmetic T>
+void square_vector(Policy &&policy, std::vector<T> &v)
+{
+    if constexpr (runs_on_pool<Policy>)
+        square_vector<std::remove_cvref_t<Policy>>(parallel::default_pool(), v);
+    else
+        std::transform(policy, v.begin(), v.end(), v.begin(), [](T x)
+                       { return x * x; });
+};
+
+template <execution_policy Policy, arithmetic T>
+T sum_vector(Policy &&policy, const std::vector<T> &v)
+{
+    if constexpr (runs_on_pool<Policy>)
+        return sum_vector<std::remove_cvref_t<Policy>>(parallel::default_pool(), v);
+    else
+        return std::reduce(policy, v.begin(), v.end(), T{0});
+};
+
+template <execution_policy Policy, arithmetic T>
+void filter_great(Policy &&policy, const std::vector<T> &v, std::vector<T> &v_copy, T a)
+{
+    if constexpr (runs_on_pool<Policy>)
+        filter_great<std::remove_cvref_t<Policy>>(parallel::default_pool(), v, v_copy, a);
+    else
+    {
+        const auto greater = [a](T x)
+        { return x > a; };
+        const std::size_t first = v_copy.size();
+        v_copy.resize(first + std::count_if(policy, v.begin(), v.end(), greater));
+        std::copy_if(policy, v.begin(), v.end(), v_copy.begin() + first, greater);
+    }
+};
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Statistical micro-benchmark harness
+// - Warmup runs before anything is measured
+// - The iteration count of a sample is calibrated so one sample lasts at least min_sample_time
+// - Several samples are taken, reporting median, MAD (median absolute deviation) and a 95%
+//   distribution-free confidence interval of the median (order statistics)
+// - Results can be written as JSON and compared against a stored baseline file
+//
+// Command line (parsed by Options::parse):
+//   --filter <substring>    only run benchmarks whose name contains substring
+//   --samples <n>           samples per benchmark (default 15)
+//   --min-time <seconds>    minimum duration of one sample (default 0.02)
+//   --warmup <seconds>      warmup duration (default 0.05)
+//   --json <file>           write results as JSON
+//   --baseline <file>       compare against a previous --json file
+//   --threshold <ratio>     flag slowdowns larger than ratio (default 0.05 = 5%)
+namespace bench
+{
+    // Keep the compiler from discarding a value it considers unused
+    template <typename T>
+    inline void DoNotOptimize(T const &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename T>
+    inline void DoNotOptimize(T &value)
+    {
+        asm volatile("" : "+r,m"(value) : : "memory");
+    }
+
+    // Force pending writes to memory to be considered observable
+    inline void ClobberMemory()
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string filter;
+        int samples = 15;
+        double min_sample_time = 0.02;
+        double warmup_time = 0.05;
+        std::string json_file;
+        std::string baseline_file;
+        double threshold = 0.05;
+
+        static Options parse(int argc, char *argv[])
+        {
+            Options o;
+            for (int i = 1; i + 1 < argc; i += 2)
+            {
+                std::string key = argv[i];
+                std::string value = argv[i + 1];
+                if (key == "--filter")
+                    o.filter = value;
+                else if (key == "--samples")
+                    o.samples = std::max(3, std::atoi(value.c_str()));
+                else if (key == "--min-time")
+                    o.min_sample_time = std::atof(value.c_str());
+                else if (key == "--warmup")
+                    o.warmup_time = std::atof(value.c_str());
+                else if (key == "--json")
+                    o.json_file = value;
+                else if (key == "--baseline")
+                    o.baseline_file = value;
+                else if (key == "--threshold")
+                    o.threshold = std::atof(value.c_str());
+                else
+                    --i; // unknown flag (e.g. --kokkos-*), skip only the key
+            }
+            return o;
+        }
+    };
+
+    struct Result
+    {
+        std::string name;
+        std::uint64_t iterations; // per sample
+        int samples;
+        double median_ns; // per iteration
+        double mad_ns;
+        double ci_low_ns;
+        double ci_high_ns;
+        double min_ns;
+        double bytes_per_iteration; // 0 when not meaningful
+    };
+
+    class Runner
+    {
+    private:
+        Options options_;
+        std::vector<Result> results_;
+
+        template <typename F>
+        static double run_batch(F &fn, std::uint64_t iterations)
+        {
+            auto start = Clock::now();
+            for (std::uint64_t i = 0; i < iterations; ++i)
+                fn();
+            ClobberMemory();
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        static double median_of(std::vector<double> v)
+        {
+            std::sort(v.begin(), v.end());
+            std::size_t n = v.size();
+            return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+        }
+
+    public:
+        explicit Runner(const Options &options) : options_(options) {}
+
+        // fn is one iteration, bytes is the memory traffic of one iteration (for GB/s)
+        template <typename F>
+        void run(const std::string &name, F &&fn, double bytes = 0.0)
+        {
+            if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos)
+                return;
+
+            // Warmup, and a first estimate of the cost of one iteration
+            std::uint64_t iterations = 1;
+            double elapsed = 0.0;
+            auto warmup_start = Clock::now();
+            while (std::chrono::duration<double>(Clock::now() - warmup_start).count() < options_.warmup_time)
+            {
+                elapsed = run_batch(fn, iterations);
+                if (elapsed < options_.min_sample_time / 10)
+                    iterations *= 2;
+            }
+
+            // Calibrate: grow the batch until one sample lasts at least min_sample_time
+            while ((elapsed = run_batch(fn, iterations)) < options_.min_sample_time)
+            {
+                double factor = elapsed > 0 ? 1.2 * options_.min_sample_time / elapsed : 10.0;
+                iterations = static_cast<std::uint64_t>(std::ceil(static_cast<double>(iterations) * std::clamp(factor, 1.5, 10.0)));
+            }
+
+            std::vector<double> per_iter(options_.samples);
+            for (auto &t : per_iter)
+                t = run_batch(fn, iterations) * 1e9 / static_cast<double>(iterations);
+
+            double median = median_of(per_iter);
+            std::vector<double> deviations(per_iter.size());
+            std::transform(per_iter.begin(), per_iter.end(), deviations.begin(), [median](double t)
+                           { return std::abs(t - median); });
+            double mad = median_of(deviations);
+
+            // 95% CI of the median: ranks n/2 -+ 1.96 sqrt(n)/2 of the sorted samples
+            std::sort(per_iter.begin(), per_iter.end());
+            double n = static_cast<double>(per_iter.size());
+            double half_width = 1.96 * std::sqrt(n) / 2.0;
+            auto lo = static_cast<std::size_t>(std::max(0.0, std::floor(n / 2.0 - half_width)));
+            auto hi = static_cast<std::size_t>(std::min(n - 1, std::ceil(n / 2.0 + half_width)));
+
+            results_.push_back({name, iterations, options_.samples, median, mad, per_iter[lo], per_iter[hi], per_iter.front(), bytes});
+            print(results_.back());
+        }
+
+        static void print(const Result &r)
+        {
+            char line[256];
+            std::snprintf(line, sizeof(line), "[BENCH] %-44s %12.1f ns  +-%8.1f (MAD)  CI95 [%.1f, %.1f]  x%llu",
+                          r.name.c_str(), r.median_ns, r.mad_ns, r.ci_low_ns, r.ci_high_ns, static_cast<unsigned long long>(r.iterations));
+            std::cout << line;
+            if (r.bytes_per_iteration > 0)
+                std::cout << "  " << r.bytes_per_iteration / r.median_ns << " GB/s";
+            std::cout << "\n";
+        }
+
+        const std::vector<Result> &results() const { return this->results_; }
+
+        void write_json(const std::string &path) const
+        {
+            std::ofstream out(path);
+            out.precision(12);
+            out << "{\n  \"benchmarks\": [\n";
+            for (std::size_t i = 0; i < results_.size(); ++i)
+            {
+                const Result &r = results_[i];
+                out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+                    << ", \"samples\": " << r.samples << ", \"median_ns\": " << r.median_ns
+                    << ", \"mad_ns\": " << r.mad_ns << ", \"ci_low_ns\": " << r.ci_low_ns
+                    << ", \"ci_high_ns\": " << r.ci_high_ns << ", \"min_ns\": " << r.min_ns
+                    << ", \"bytes_per_iteration\": " << r.bytes_per_iteration << "}"
+                    << (i + 1 < results_.size() ? ",\n" : "\n");
+            }
+            out << "  ]\n}\n";
+        }
+
+        // Reads the name/median_ns pairs of a file produced by write_json
+        static std::map<std::string, double> read_baseline(const std::string &path)
+        {
+            std::map<std::string, double> medians;
+            std::ifstream in(path);
+            std::string line;
+            while (std::getline(in, line))
+            {
+                auto name_pos = line.find("\"name\": \"");
+                auto median_pos = line.find("\"median_ns\": ");
+                if (name_pos == std::string::npos || median_pos == std::string::npos)
+                    continue;
+                name_pos += 9;
+                std::string name = line.substr(name_pos, line.find('"', name_pos) - name_pos);
+                medians[name] = std::atof(line.c_str() + median_pos + 13);
+            }
+            return medians;
+        }
+
+        // Returns the number of benchmarks slower than baseline by more than the threshold
+        // A slowdown only counts when the CI of the new median lies entirely above the threshold
+        int compare_baseline(const std::string &path) const
+        {
+            auto baseline = read_baseline(path);
+            if (baseline.empty())
+            {
+                std::cerr << "[BENCH] baseline " << path << " is empty or missing\n";
+                return 0;
+            }
+            int regressions = 0;
+            std::cout << "\n=== Comparison against " << path << " (threshold " << options_.threshold * 100 << "%) ===\n";
+            for (const auto &r : results_)
+            {
+                auto it = baseline.find(r.name);
+                if (it == baseline.end() || it->second <= 0)
+                    continue;
+                double change = r.median_ns / it->second - 1.0;
+                bool slower = r.ci_low_ns > it->second * (1.0 + options_.threshold);
+                regressions += slower;
+                char line[256];
+                std::snprintf(line, sizeof(line), "%-44s %12.1f -> %12.1f ns  %+7.1f%% %s\n",
+                              r.name.c_str(), it->second, r.median_ns, change * 100.0, slower ? "REGRESSION" : "");
+                std::cout << line;
+            }
+            return regressions;
+        }
+
+        // Writes JSON / compares with baseline as requested on the command line, returns the exit code
+        int finish() const
+        {
+            if (!options_.json_file.empty())
+                write_json(options_.json_file);
+            if (!options_.baseline_file.empty() && compare_baseline(options_.baseline_file) > 0)
+                return 1;
+            return 0;
+        }
+    };
+}
@@ -0,0 +1,118 @@
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RAII-buffer.hpp"
+#include "algorithms.hpp"
+#include "benchmark.hpp"
+#include "geometry.hpp"
+#include "grade_tracker.hpp"
+
+// Benchmark suite for the non-Kokkos examples
+// Usage: ./benchmarks [--json current.json] [--baseline previous.json] [--threshold 0.05] [--filter name]
+int main(int argc, char *argv[])
+{
+    bench::Runner runner(bench::Options::parse(argc, argv));
+
+    // RAIIBuffer
+    runner.run("RAIIBuffer/construct 1024 int", []()
+               { RAIIBuffer<int> buf(1024); bench::DoNotOptimize(buf); });
+    runner.run("RAIIBuffer/move construct", []()
+               {
+        RAIIBuffer<int> buf(16);
+        RAIIBuffer<int> moved = std::move(buf);
+        bench::DoNotOptimize(moved); });
+    {
+        const size_t n = 1 << 20;
+        RAIIBuffer<int> buf(n);
+        runner.run(
+            "RAIIBuffer/checked fill 1M int", [&buf]()
+            {
+            for (size_t i = 0; i < buf.size(); ++i)
+                buf[i] = static_cast<int>(i);
+            bench::ClobberMemory(); },
+            double(n * sizeof(int)));
+    }
+
+    // Geometry collections
+    {
+        const int n = 100'000;
+        ShapeCollection<Point> points;
+        ShapeCollection<LineSegment> lines;
+        ShapeCollectionShared<LineSegment> shared_lines;
+        for (int i = 0; i < n; ++i)
+        {
+            points.add(Point(float(i), float(-i)));
+            lines.add(LineSegment(Point(float(i), 0.0f), Point(0.0f, float(i))));
+            shared_lines.add(std::make_shared<LineSegment>(Point(float(i), 0.0f), Point(0.0f, float(i))));
+        }
+        runner.run("ShapeCollection<Point>/translate_all 100k", [&points]()
+                   { points.translate_all(0.5f, -0.5f); bench::ClobberMemory(); });
+        runner.run("ShapeCollection<LineSegment>/translate_all 100k", [&lines]()
+                   { lines.translate_all(0.5f, -0.5f); bench::ClobberMemory(); });
+        runner.run("ShapeCollectionShared<LineSegment>/translate_all 100k", [&shared_lines]()
+                   { shared_lines.translate_all(Point(0.5f, -0.5f)); bench::ClobberMemory(); });
+
+        Point a(1.0f, 2.0f), b(4.0f, 6.0f);
+        runner.run("Point/distance_to", [&a, &b]()
+                   {
+            bench::DoNotOptimize(a);
+            float d = a.distance_to(b);
+            bench::DoNotOptimize(d); });
+    }
+
+    // Grade tracker
+    {
+        std::vector<std::string> names;
+        for (int i = 0; i < 1000; ++i)
+            names.push_back("student_" + std::to_string(i));
+
+        runner.run("grade_tracker/add_grade 1000x10", [&names]()
+                   {
+            std::map<std::string, std::vector<int>> tracker;
+            for (int g = 0; g < 10; ++g)
+                for (const auto &name : names)
+                    add_grade(tracker, name, g);
+            bench::DoNotOptimize(tracker); });
+
+        std::map<std::string, std::vector<int>> tracker;
+        for (int g = 0; g < 10; ++g)
+            for (const auto &name : names)
+                add_grade(tracker, name, g);
+
+        // descending_avg prints its result, keep the terminal out of the measurement
+        std::ofstream null_stream("/dev/null");
+        runner.run("grade_tracker/descending_avg 1000", [&tracker, &null_stream]()
+                   {
+            auto *old = std::cout.rdbuf(null_stream.rdbuf());
+            descending_avg(tracker);
+            std::cout.rdbuf(old); });
+    }
+
+    // std algorithms templates
+    {
+        const size_t n = 1 << 20;
+        std::vector<int> ones(n, 1); // squaring keeps the values stable between iterations
+        // 0..1023 repeated: the sum (about 5.4e8) fits in the int sum_vector adds in
+        std::vector<int> values(n);
+        for (size_t i = 0; i < n; ++i)
+            values[i] = static_cast<int>(i % 1024);
+
+        runner.run("algorithms/square_vector 1M int", [&ones]()
+                   { square_vector(ones); bench::ClobberMemory(); }, double(2 * n * sizeof(int)));
+        runner.run("algorithms/sum_vector 1M int", [&values]()
+                   {
+            int s = sum_vector(values);
+            bench::DoNotOptimize(s); }, double(n * sizeof(int)));
+        runner.run("algorithms/filter_great 1M int (50%)", [&values]()
+                   {
+            std::vector<int> out;
+            filter_great(values, out, 511);
+            bench::DoNotOptimize(out.data()); }, double(n * sizeof(int)));
+    }
+
+    return runner.finish();
+}
@@ -0,0 +1,30 @@
+# The Kokkos example programs, shared by the top-level build and the per-backend sub-builds
+# (cmake/kokkos-backend). Each program is one .cpp file in the repository root.
+set(KOKKOS_PROGRAMS
+    kokkos-autotune
+    kokkos-benchmarks
+    kokkos-compact
+    kokkos-expressions
+    kokkos-gemm
+    kokkos-parallel-patterns
+    kokkos-random-fill
+    kokkos-reducers
+    kokkos-selection
+    kokkos-simd-reductions
+    kokkos-sparse
+    kokkos-stencil
+    kokkos-task-graph
+    kokkos-transpose
+    kokkos-view-io
+    kokkos-views
+    kokkos-views-pro
+    kokkos-workspace)
+
+# One executable per program, linked against the Kokkos found by find_package(Kokkos)
+function(add_kokkos_programs source_dir)
+    foreach(program IN LISTS KOKKOS_PROGRAMS)
+        add_executable(${program} ${source_dir}/${program}.cpp)
+        target_include_directories(${program} PRIVATE ${source_dir})
+        target_link_libraries(${program} PRIVATE Kokkos::kokkos Threads::Threads)
+    endforeach()
+endfunction()
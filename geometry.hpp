@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+template <typename T>
+concept Printable = requires(T a) {
+    { std::cout << a } -> std::same_as<std::ostream &>;
+};
+
+// For this type T to satisfy Translatable, it must have a method translate(float, float) that returns void.
+template <typename T>
+concept Translatable = requires(T a, float dx, float dy) {
+    { a.translate(dx, dy) } -> std::same_as<void>;
+};
+
+class Point
+{
+private:
+    float x, y; // Encapsulated data
+
+public:
+    // Empty constructor
+    Point() : x(), y() {}
+
+    // Constructor
+    Point(float x_val, float y_val) : x(x_val), y(y_val) {}
+
+    // Copy constructor
+    Point(const Point &other) : x(other.getX()), y(other.getY())
+    {
+        // std::cout << "Copied Point\n";
+    }
+
+    ~Point()
+    {
+        // std::cout << "Point destroyed.\n";
+    }
+
+    // Accessors
+    float getX() const { return this->x; }
+    float getY() const { return this->y; }
+
+    void setX(float val) { this->x = val; }
+    void setY(float val) { this->y = val; }
+
+    // Method
+    void translate(float dx, float dy)
+    {
+        this->x += dx;
+        this->y += dy;
+    }
+
+    float norm(Point p) const
+    {
+        return std::sqrt(p.getX() * p.getX() + p.getY() * p.getY());
+    }
+
+    Point operator+(const Point &other) const
+    {
+        return Point(this->x + other.getX(), this->y + other.getY());
+    }
+
+    Point operator-(const Point &other) const
+    {
+        return Point(this->x - other.getX(), this->y - other.getY());
+    }
+
+    // Copy assignement operator
+    Point &operator=(const Point &other)
+    {
+        if (this != &other)
+        { // Avoids self assignment by checking the same memory space addresses
+            this->x = other.getX();
+            this->y = other.getY();
+        }
+        std::cout << "Assigned Point \n";
+        return *this;
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const Point &p);
+
+    bool operator==(const Point &other) const
+    {
+        return x == other.getX() && y == other.getY();
+    }
+
+    float distance_to(const Point &other) const
+    {
+        float dx = x - other.x;
+        float dy = y - other.y;
+        Point p(dx, dy);
+        return norm(p);
+    }
+
+    // Method to print
+    void print() const
+    {
+        std::cout << "(" << x << ", " << y << ")\n";
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Point &p)
+{
+    os << "(" << p.x << ", " << p.y << ")";
+    return os;
+}
+
+class LineSegment
+{
+private:
+    Point p1, p2;
+
+public:
+    LineSegment() : p1(), p2() {}
+
+    LineSegment(const Point &p1_val, const Point &p2_val) : p1(p1_val), p2(p2_val) {}
+
+    LineSegment(const LineSegment &other) : p1(other.p1), p2(other.p2) {}
+
+    ~LineSegment()
+    {
+        // std::cout << "Line segment destroyed\n";
+    }
+
+    void translate(float dx, float dy)
+    {
+        this->p1.translate(dx, dy);
+        this->p2.translate(dx, dy);
+    }
+
+    LineSegment &operator=(const LineSegment &other)
+    {
+        if (this != &other)
+        {
+            this->p1 = other.p1;
+            this->p2 = other.p2;
+        }
+        return *this;
+    }
+
+    bool operator==(const LineSegment &other) const
+    {
+        return this->p1 == other.p1 && this->p2 == other.p2;
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const LineSegment &line);
+
+    float length() const
+    {
+        return p1.distance_to(p2);
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const LineSegment &line)
+{
+    os << "[ " << line.p1 << " -> " << line.p2 << " ]";
+    return os;
+}
+
+class Rectangle
+{
+    float width, height;
+
+public:
+    Rectangle(float w, float h) : width(w), height(h) {} // initialization list for efficiency
+
+    float area() const { return width * height; }
+};
+
+template <Translatable T>
+class ShapeCollection
+{
+private:
+    std::vector<T> shapes;
+
+public:
+    // Empty constructor
+    ShapeCollection() = default;
+    // The same as:
+    // ShapeCollection() : shape() {}
+
+    // Constructor
+    void add(const T &elem)
+    {
+        this->shapes.emplace_back(elem);
+    }
+
+    void translate_all(float dx, float dy)
+    {
+        for (auto &elem : this->shapes)
+            elem.translate(dx, dy);
+    }
+
+    void print_all() const
+        requires Printable<T>
+    {
+        for (const auto &elem : this->shapes)
+            std::cout << elem << "\n";
+    }
+
+    ~ShapeCollection()
+    {
+        std::cout << "Shape destroyed.\n";
+    }
+};
+
+template <typename T>
+class ShapeCollectionShared
+{
+private:
+    std::vector<std::shared_ptr<T>> shapes;
+
+public:
+    ShapeCollectionShared() = default;
+
+    void add(const std::shared_ptr<T> &shape)
+    {
+        shapes.push_back(shape);
+    }
+
+    void translate_all(const Point &delta)
+    {
+        for (auto &s : shapes)
+            s->translate(delta.getX(), delta.getY()); // use -> for shared_ptr
+    }
+
+    void print_all() const
+    {
+        for (const auto &s : shapes)
+            std::cout << *s << "\n"; // dereference for printing
+    }
+
+    ~ShapeCollectionShared()
+    {
+        std::cout << "Shared ShapeCollection destroyed\n";
+    }
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+inline void add_grade(std::map<std::string, std::vector<int>> &tracker, const std::string &name, const int grade)
+{
+    tracker[name].push_back(grade);
+}
+
+inline void avg_per_student(const std::map<std::string, std::vector<int>> &tracker)
+{
+    for (const auto &[name, v] : tracker)
+    {
+        double sum = static_cast<double>(std::accumulate(v.begin(), v.end(), double{0}));
+        double avg = sum / static_cast<double>(v.size());
+        std::cout << name << " -> " << avg << "\n";
+    }
+}
+
+inline void descending_avg(std::map<std::string, std::vector<int>> &tracker)
+{
+    auto cmp = [](const auto &a, const auto &b)
+    {
+        if (a.second != b.second)
+            return a.second > b.second;
+        else
+            return a.first < b.first;
+    };
+
+    std::set<std::pair<std::string, double>, decltype(cmp)> desc_set(cmp);
+
+    for (const auto &[name, v] : tracker)
+    {
+        double sum = static_cast<double>(std::accumulate(v.begin(), v.end(), double{0}));
+        double avg = sum / static_cast<double>(v.size());
+        desc_set.insert({name, avg});
+    }
+    for (const auto &[name, avg] : desc_set)
+        std::cout << name << " -> " << avg << " \n";
+}
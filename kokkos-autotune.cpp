@@ -0,0 +1,81 @@
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "kokkos-autotune.hpp"
+#include "tsc-clock.hpp"
+
+// The fill, Frobenius and dot kernels of kokkos-parallel-patterns.cpp (Parts 2 and 4),
+// launched through the autotuner
+// The first run tunes during its first iterations and writes the cache file, a second run
+// starts with the tuned configurations (the report then says "from cache").
+// Usage: ./kokkos-autotune [--iterations N] [--kokkos-num-threads=T]
+//   KOKKOS_AUTOTUNE_CACHE=file to choose the cache, KOKKOS_AUTOTUNE=off for the Kokkos defaults
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    clocks::init();
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    int iterations = 20;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--iterations")
+            iterations = std::atoi(argv[i + 1]);
+
+    const std::int64_t rows = 2048, cols = 2048;
+    const std::int64_t n = 1 << 24;
+    Kokkos::View<double **> A("A", rows, cols);
+    Kokkos::View<double **> B("B", rows, cols);
+    Kokkos::View<double **> C("C", rows, cols);
+    Kokkos::View<double *> a("a", n);
+    Kokkos::View<double *> b("b", n);
+
+    std::cout << "iteration  fill_A_B(us)  Frobenius(us)  fill_a_b(us)  dot(us)\n";
+    double norm = 0, dot = 0;
+    for (int it = 0; it < iterations; ++it)
+    {
+        double us[4];
+        std::int64_t t = clocks::now_ticks();
+        auto lap = [&](int k)
+        {
+            Kokkos::fence();
+            std::int64_t now = clocks::now_ticks();
+            us[k] = clocks::to_ns(static_cast<double>(now - t)) / 1e3;
+            t = now;
+        };
+
+        autotune::md_for("fill_A_B-find_C", {rows, cols}, KOKKOS_LAMBDA(std::int64_t i, std::int64_t j) {
+            A(i,j) = i + j;
+            B(i,j) = i * j;
+            C(i,j) = A(i,j) + B(i,j); });
+        lap(0);
+
+        double sum = 0;
+        autotune::range_reduce("Frobenius_C", rows * cols, KOKKOS_LAMBDA(std::int64_t id, double &tempSum) {
+            std::int64_t i = id / cols;
+            std::int64_t j = id % cols;
+            tempSum += C(i,j) * C(i,j); }, sum);
+        norm = std::sqrt(sum);
+        lap(1);
+
+        autotune::range_for("fill_a_b", n, KOKKOS_LAMBDA(std::int64_t i) {
+            a(i) = i;
+            b(i) = 2*i; });
+        lap(2);
+
+        dot = 0;
+        autotune::range_reduce("dot_a_b", n, KOKKOS_LAMBDA(std::int64_t i, double &tempDot) { tempDot += a(i) * b(i); }, dot);
+        lap(3);
+
+        std::printf("%9d %13.1f %14.1f %13.1f %8.1f\n", it, us[0], us[1], us[2], us[3]);
+    }
+    std::cout << "Frobenius norm of C " << norm << ", dot a*b " << dot << "\n\n";
+
+    autotune::Tuner::instance().report(std::cout);
+    return 0;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tsc-clock.hpp"
+
+// Online autotuning of RangePolicy chunk sizes and MDRangePolicy<Rank<2>> tile shapes
+// Drop-in launchers keyed by (kernel label, extents, concurrency):
+//   autotune::range_for("fill_a_b", n, KOKKOS_LAMBDA(std::int64_t i) { ... });
+//   autotune::range_reduce("dot_a_b", n, KOKKOS_LAMBDA(std::int64_t i, double &u) { ... }, dot);
+//   autotune::md_for("fill_A_B-find_C", {rows, cols}, KOKKOS_LAMBDA(std::int64_t i, std::int64_t j) { ... });
+//   autotune::md_reduce("Frobenius_C", {rows, cols}, KOKKOS_LAMBDA(std::int64_t i, std::int64_t j, double &u) { ... }, sum);
+// The first invocations of a key each run the kernel once with the next candidate
+// configuration and time it (every invocation still does its real work, only the policy
+// changes); after rounds x candidates invocations the fastest is kept and written to the
+// cache file, which later runs load so they start with the tuned configuration.
+// - KOKKOS_AUTOTUNE_CACHE: cache file (default kokkos-autotune.cache in the working directory)
+// - KOKKOS_AUTOTUNE=off: always use the Kokkos defaults, no timing
+namespace autotune
+{
+    // 0 leaves the chunk size / tile to Kokkos
+    inline const std::vector<int> &chunk_candidates()
+    {
+        static const std::vector<int> c = {0, 64, 256, 1024, 4096, 16384};
+        return c;
+    }
+
+    inline const std::vector<std::array<int, 2>> &tile_candidates()
+    {
+        static const std::vector<std::array<int, 2>> t = {{0, 0}, {2, 256}, {4, 128}, {8, 64}, {16, 32}, {32, 16}, {64, 64}};
+        return t;
+    }
+
+    class Tuner
+    {
+    private:
+        struct Entry
+        {
+            std::vector<double> best_ns; // per candidate, < 0 until measured
+            std::vector<int> runs;
+            int next = 0;
+            int chosen = -1;
+        };
+
+        std::map<std::string, Entry> entries_;
+        std::string path_;
+        bool enabled_ = true;
+        int rounds_ = 2;
+
+        Tuner()
+        {
+            const char *mode = std::getenv("KOKKOS_AUTOTUNE");
+            enabled_ = !(mode && std::strcmp(mode, "off") == 0);
+            const char *path = std::getenv("KOKKOS_AUTOTUNE_CACHE");
+            path_ = path ? path : "kokkos-autotune.cache";
+            load();
+        }
+
+        // One line per tuned key: key<TAB>chosen candidate index<TAB>candidate count
+        void load()
+        {
+            std::ifstream in(path_);
+            std::string line;
+            while (std::getline(in, line))
+            {
+                if (line.empty() || line[0] == '#')
+                    continue;
+                std::size_t tab = line.rfind('\t');
+                std::size_t tab0 = tab == std::string::npos ? tab : line.rfind('\t', tab - 1);
+                if (tab0 == std::string::npos)
+                    continue;
+                Entry e;
+                e.chosen = std::atoi(line.c_str() + tab0 + 1);
+                e.best_ns.assign(std::atoi(line.c_str() + tab + 1), -1.0);
+                e.runs.assign(e.best_ns.size(), 0);
+                entries_[line.substr(0, tab0)] = e;
+            }
+        }
+
+        void save() const
+        {
+            std::ofstream out(path_);
+            out << "# kokkos autotune cache: key<TAB>chosen candidate<TAB>candidate count\n";
+            for (const auto &[key, e] : entries_)
+                if (e.chosen >= 0)
+                    out << key << '\t' << e.chosen << '\t' << e.best_ns.size() << '\n';
+        }
+
+    public:
+        static Tuner &instance()
+        {
+            static Tuner t;
+            return t;
+        }
+
+        void set_rounds(int rounds) { rounds_ = std::max(1, rounds); }
+        const std::string &cache_file() const { return this->path_; }
+
+        static std::string key(const char *kind, const std::string &label, const std::int64_t *extents, int rank)
+        {
+            std::ostringstream os;
+            os << kind << '|' << label << '|';
+            for (int r = 0; r < rank; ++r)
+                os << (r ? "x" : "") << extents[r];
+            os << "|threads=" << Kokkos::DefaultExecutionSpace().concurrency();
+            return os.str();
+        }
+
+        // Candidate to run for this invocation; measure is set when it should be timed
+        int select(const std::string &key, int candidates, bool &measure)
+        {
+            measure = false;
+            if (!enabled_)
+                return 0;
+            Entry &e = entries_[key];
+            // A cache entry written for another candidate list is stale, tune again
+            if (static_cast<int>(e.best_ns.size()) != candidates || e.chosen >= candidates)
+                e = Entry{std::vector<double>(candidates, -1.0), std::vector<int>(candidates, 0)};
+            if (e.chosen >= 0)
+                return e.chosen;
+            measure = true;
+            return e.next;
+        }
+
+        void record(const std::string &key, int candidate, double ns)
+        {
+            Entry &e = entries_[key];
+            double &best = e.best_ns[candidate];
+            best = best < 0 ? ns : std::min(best, ns);
+            e.runs[candidate] += 1;
+            e.next = (e.next + 1) % static_cast<int>(e.best_ns.size());
+            if (*std::min_element(e.runs.begin(), e.runs.end()) >= rounds_)
+            {
+                e.chosen = static_cast<int>(std::min_element(e.best_ns.begin(), e.best_ns.end()) - e.best_ns.begin());
+                save();
+            }
+        }
+
+        // Chosen (or pending) configuration per key
+        void report(std::ostream &os) const
+        {
+            os << "=== Autotune (" << path_ << ") ===\n";
+            if (!enabled_)
+            {
+                os << "  disabled (KOKKOS_AUTOTUNE=off), Kokkos default chunks and tiles\n";
+                return;
+            }
+            for (const auto &[key, e] : entries_)
+            {
+                bool range = key.compare(0, 6, "range|") == 0;
+                os << "  " << key << ": ";
+                if (e.chosen < 0)
+                {
+                    int done = 0;
+                    for (int r : e.runs)
+                        done += std::min(r, rounds_);
+                    os << "tuning (" << done << "/" << rounds_ * static_cast<int>(e.runs.size()) << " runs)\n";
+                    continue;
+                }
+                os << describe(range, e.chosen);
+                if (e.best_ns[e.chosen] >= 0)
+                    os << "  " << e.best_ns[e.chosen] / 1e3 << " us, default " << e.best_ns[0] / 1e3 << " us";
+                else
+                    os << "  (from cache)";
+                os << "\n";
+            }
+        }
+
+        static std::string describe(bool range, int candidate)
+        {
+            if (range)
+            {
+                int c = chunk_candidates()[candidate];
+                return c ? "chunk " + std::to_string(c) : "chunk default";
+            }
+            auto t = tile_candidates()[candidate];
+            return t[0] ? "tile " + std::to_string(t[0]) + "x" + std::to_string(t[1]) : "tile default";
+        }
+    };
+
+    // Runs launch(candidate), timed between fences while the key is being tuned
+    template <class Launch>
+    void tuned(const std::string &key, int candidates, const Launch &launch)
+    {
+        Tuner &tuner = Tuner::instance();
+        bool measure = false;
+        int candidate = tuner.select(key, candidates, measure);
+        if (!measure)
+        {
+            launch(candidate);
+            return;
+        }
+        Kokkos::fence();
+        std::int64_t start = clocks::now_ticks();
+        launch(candidate);
+        Kokkos::fence();
+        tuner.record(key, candidate, clocks::to_ns(static_cast<double>(clocks::now_ticks() - start)));
+    }
+
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace>
+    Kokkos::RangePolicy<ExecSpace> range_policy(std::int64_t n, int candidate)
+    {
+        Kokkos::RangePolicy<ExecSpace> policy(0, n);
+        if (int chunk = chunk_candidates()[candidate])
+            policy.set_chunk_size(chunk);
+        return policy;
+    }
+
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace>
+    Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2>> md_policy(const std::array<std::int64_t, 2> &extents, int candidate)
+    {
+        auto t = tile_candidates()[candidate];
+        if (!t[0])
+            return Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2>>({0, 0}, {extents[0], extents[1]});
+        return Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2>>({0, 0}, {extents[0], extents[1]}, {std::int64_t(t[0]), std::int64_t(t[1])});
+    }
+
+    template <class Functor>
+    void range_for(const std::string &label, std::int64_t n, const Functor &f)
+    {
+        tuned(Tuner::key("range", label, &n, 1), static_cast<int>(chunk_candidates().size()), [&](int c)
+              { Kokkos::parallel_for(label, range_policy(n, c), f); });
+    }
+
+    template <class Functor, class T>
+    void range_reduce(const std::string &label, std::int64_t n, const Functor &f, T &result)
+    {
+        tuned(Tuner::key("range", label, &n, 1), static_cast<int>(chunk_candidates().size()), [&](int c)
+              { Kokkos::parallel_reduce(label, range_policy(n, c), f, result); });
+    }
+
+    template <class Functor>
+    void md_for(const std::string &label, const std::array<std::int64_t, 2> &extents, const Functor &f)
+    {
+        tuned(Tuner::key("md", label, extents.data(), 2), static_cast<int>(tile_candidates().size()), [&](int c)
+              { Kokkos::parallel_for(label, md_policy(extents, c), f); });
+    }
+
+    template <class Functor, class T>
+    void md_reduce(const std::string &label, const std::array<std::int64_t, 2> &extents, const Functor &f, T &result)
+    {
+        tuned(Tuner::key("md", label, extents.data(), 2), static_cast<int>(tile_candidates().size()), [&](int c)
+              { Kokkos::parallel_reduce(label, md_policy(extents, c), f, result); });
+    }
+}
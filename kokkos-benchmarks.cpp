@@ -0,0 +1,103 @@
+#include <Kokkos_Core.hpp>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+#include "kokkos-reducers.hpp"
+
+// Benchmark suite for the kernels of kokkos-parallel-patterns.cpp and kokkos-views.cpp
+// Every iteration ends with Kokkos::fence() so asynchronous backends are timed correctly
+// Usage: ./kokkos-benchmarks [--kokkos-num-threads=N] [--json current.json] [--baseline previous.json]
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+
+    const int n = 1 << 20;
+    Kokkos::View<double *> a("a", n);
+    Kokkos::View<double *> b("b", n);
+
+    runner.run(
+        "fill_a_b 1M", [&]()
+        {
+        Kokkos::parallel_for("fill_a_b", n, KOKKOS_LAMBDA(int i) {
+            a(i) = i;
+            b(i) = 2*i; });
+        Kokkos::fence(); },
+        2.0 * n * sizeof(double));
+
+    runner.run(
+        "dot_a_b 1M", [&]()
+        {
+        double dot = 0;
+        Kokkos::parallel_reduce("dot_a_b", n, KOKKOS_LAMBDA(int i, double &tempDot) { tempDot += a(i) * b(i); }, dot);
+        bench::DoNotOptimize(dot); },
+        2.0 * n * sizeof(double));
+
+    runner.run(
+        "scale b = 2.8 a 1M", [&]()
+        {
+        Kokkos::parallel_for("scale", n, KOKKOS_LAMBDA(int i) { b(i) = 2.8 * a(i); });
+        Kokkos::fence(); },
+        2.0 * n * sizeof(double));
+
+    runner.run(
+        "reduce vector_reduce (sum/min/max/count) 1M", [&]()
+        {
+        reducers::StatsValue stats;
+        Kokkos::parallel_reduce("reduce vector_reduce", n, KOKKOS_LAMBDA(int i, reducers::StatsValue &update) { update.add(a(i), 0.5); }, reducers::Stats<>(stats));
+        bench::DoNotOptimize(stats); },
+        1.0 * n * sizeof(double));
+
+    runner.run(
+        "finding_extrema 1M", [&]()
+        {
+        Kokkos::MinMaxLoc<double, int>::value_type result;
+        Kokkos::parallel_reduce("finding_extrema", n, KOKKOS_LAMBDA(int i, Kokkos::MinMaxLoc<double, int>::value_type &update) {
+            if (b(i) < update.min_val) { update.min_val = b(i); update.min_loc = i; }
+            if (b(i) > update.max_val) { update.max_val = b(i); update.max_loc = i; } }, Kokkos::MinMaxLoc<double, int>(result));
+        bench::DoNotOptimize(result); },
+        1.0 * n * sizeof(double));
+
+    Kokkos::View<int *> flag("flag", n);
+    Kokkos::View<int *> scan("scan", n);
+    Kokkos::parallel_for("filling_flag", n, KOKKOS_LAMBDA(int i) { flag(i) = i % 3 == 0; });
+    runner.run(
+        "generate_index (scan) 1M", [&]()
+        {
+        Kokkos::parallel_scan("generate_index", n, KOKKOS_LAMBDA(int i, int &update, bool final) {
+            if(flag(i)) update++;
+            if(final) scan(i) = update; });
+        Kokkos::fence(); },
+        2.0 * n * sizeof(int));
+
+    const int m = 1000;
+    Kokkos::View<double **> A("A", m, m);
+    Kokkos::View<double **> B("B", m, m);
+    Kokkos::View<double **> C("C", m, m);
+    runner.run(
+        "fill_A_B-find_C 1000x1000", [&]()
+        {
+        Kokkos::parallel_for("fill_A_B-find_C", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {m, m}), KOKKOS_LAMBDA(int i, int j) {
+            A(i,j) = i + j;
+            B(i,j) = i * j;
+            C(i,j) = A(i,j) + B(i,j); });
+        Kokkos::fence(); },
+        3.0 * m * m * sizeof(double));
+
+    runner.run(
+        "Frobenius_C 1000x1000", [&]()
+        {
+        double sum = 0;
+        Kokkos::parallel_reduce("Frobenius_C", m * m, KOKKOS_LAMBDA(int id, double &tempSum) {
+            int i = id / C.extent(1);
+            int j = id % C.extent(1);
+            tempSum += C(i,j) * C(i,j); }, sum);
+        bench::DoNotOptimize(sum); },
+        1.0 * m * m * sizeof(double));
+
+    return runner.finish();
+}
@@ -0,0 +1,137 @@
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "kokkos-compact.hpp"
+#include "kokkos-random.hpp"
+
+// Compaction throughput of compact::compact against the flag / scan / scatter sequence of
+// Part 3 of kokkos-parallel-patterns.cpp, at several sizes and selectivities
+// Usage: ./kokkos-compact [--size N]... [--kokkos-num-threads=T] [--json file]
+//   --size may be repeated (default 1M and 16M ints); 1B ints needs 8 GB for input and output
+// Results are checked against std::copy_if / std::stable_partition / std::unique.
+
+std::vector<std::int64_t> parse_sizes(int argc, char *argv[])
+{
+    std::vector<std::int64_t> sizes;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--size")
+            sizes.push_back(std::atoll(argv[i + 1]));
+    if (sizes.empty())
+        sizes = {1 << 20, 1 << 24};
+    return sizes;
+}
+
+// The Part 3 pattern completed with a scatter: flags, inclusive scan, host read of the count, scatter
+std::int64_t three_pass(const Kokkos::View<int *> &in, const Kokkos::View<int *> &out, const Kokkos::View<std::int64_t *> &offsets, int threshold)
+{
+    const std::int64_t n = static_cast<std::int64_t>(in.extent(0));
+    Kokkos::parallel_for("three_pass_flags", n, KOKKOS_LAMBDA(std::int64_t i) { offsets(i) = in(i) < threshold ? 1 : 0; });
+    Kokkos::parallel_scan("three_pass_scan", n, KOKKOS_LAMBDA(std::int64_t i, std::int64_t &update, bool final) {
+        update += offsets(i);
+        if (final)
+            offsets(i) = update; });
+    std::int64_t count = 0;
+    Kokkos::deep_copy(count, Kokkos::subview(offsets, n - 1));
+    Kokkos::parallel_for("three_pass_scatter", n, KOKKOS_LAMBDA(std::int64_t i) {
+        if (in(i) < threshold)
+            out(offsets(i) - 1) = in(i); });
+    return count;
+}
+
+bool report(const char *what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+bool verify(std::int64_t n)
+{
+    Kokkos::View<int *> in("in", n), out("out", n);
+    Kokkos::View<std::int64_t *> indices("indices", n);
+    random_fill::Filler<> random(2024);
+    random.integer(in, 0, 100);
+    auto pred = KOKKOS_LAMBDA(int v) { return v < 30; };
+
+    auto in_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), in);
+    std::vector<int> values(in_host.data(), in_host.data() + n);
+    std::vector<int> expected;
+    auto host_pred = [](int v)
+    { return v < 30; };
+    bool ok = true;
+
+    std::copy_if(values.begin(), values.end(), std::back_inserter(expected), host_pred);
+    std::int64_t count = compact::compact(in, out, pred);
+    auto out_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), out);
+    ok &= report("compact matches std::copy_if", count == static_cast<std::int64_t>(expected.size()) && std::equal(expected.begin(), expected.end(), out_host.data()));
+
+    count = compact::compact_indices(in, indices, pred);
+    auto indices_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), indices);
+    bool indices_ok = count == static_cast<std::int64_t>(expected.size());
+    for (std::int64_t k = 0; indices_ok && k < count; ++k)
+        indices_ok = values[indices_host(k)] == expected[k];
+    ok &= report("compact_indices points at the selected elements", indices_ok);
+
+    std::vector<int> partitioned = values;
+    std::stable_partition(partitioned.begin(), partitioned.end(), host_pred);
+    count = compact::partition(in, out, pred);
+    Kokkos::deep_copy(out_host, out);
+    ok &= report("partition matches std::stable_partition", count == static_cast<std::int64_t>(expected.size()) && std::equal(partitioned.begin(), partitioned.end(), out_host.data()));
+
+    // Runs of equal values for unique
+    Kokkos::parallel_for("runs", n, KOKKOS_LAMBDA(std::int64_t i) { in(i) = static_cast<int>(i / 7 + (i % 7 == 3)); });
+    Kokkos::deep_copy(in_host, in);
+    values.assign(in_host.data(), in_host.data() + n);
+    std::int64_t expected_unique = std::unique(values.begin(), values.end()) - values.begin();
+    count = compact::unique(in, out);
+    Kokkos::deep_copy(out_host, out);
+    ok &= report("unique matches std::unique", count == expected_unique && std::equal(values.begin(), values.begin() + expected_unique, out_host.data()));
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    std::cout << "\n=== Verification (n = 1000003) ===\n";
+    bool ok = verify(1000003);
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    for (std::int64_t n : parse_sizes(argc, argv))
+    {
+        Kokkos::View<int *> in("in", n), out("out", n);
+        Kokkos::View<std::int64_t *> offsets("offsets", n);
+        random_fill::Filler<> random(2024);
+        random.integer(in, 0, 100);
+
+        for (int selectivity : {1, 10, 50, 90})
+        {
+            const int threshold = selectivity; // values are uniform in [0, 100)
+            const std::string suffix = " n=" + std::to_string(n) + " keep " + std::to_string(selectivity) + "%";
+            std::int64_t kept = compact::compact(in, out, KOKKOS_LAMBDA(int v) { return v < threshold; });
+            ok &= kept == three_pass(in, out, offsets, threshold);
+            // Bytes: read the input once, write the kept elements
+            const double bytes = double(n) * sizeof(int) + double(kept) * sizeof(int);
+
+            runner.run(
+                "compact fused" + suffix, [&]()
+                { bench::DoNotOptimize(compact::compact(in, out, KOKKOS_LAMBDA(int v) { return v < threshold; })); },
+                bytes);
+            runner.run(
+                "compact three-pass" + suffix, [&]()
+                { bench::DoNotOptimize(three_pass(in, out, offsets, threshold)); Kokkos::fence(); },
+                bytes);
+        }
+    }
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+
+// Stream compaction on 1D Views, built on parallel_scan
+// The predicate is evaluated inside the scan (no flag array), the selected elements are
+// scattered in the final pass, and the number of selected elements comes back as the
+// scan total, so there is no separate kernel or deep_copy to read the last offset.
+//
+//   std::int64_t kept = compact::compact(in, out, KOKKOS_LAMBDA(int v) { return v > 5; });
+//   // out(0 .. kept) holds the selected elements of in, in their original order
+//
+// out must have at least in.extent(0) elements (partition writes all of them).
+namespace compact
+{
+    // Calls emit(i, position) for every i in [0, n) where keep(i) holds, positions 0, 1, 2, ...
+    // in index order, and returns how many were kept
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace, class Keep, class Emit>
+    std::int64_t select(const char *label, std::int64_t n, const Keep &keep, const Emit &emit)
+    {
+        std::int64_t count = 0;
+        Kokkos::parallel_scan(label, Kokkos::RangePolicy<ExecSpace>(0, n), KOKKOS_LAMBDA(std::int64_t i, std::int64_t &offset, bool final) {
+                if (keep(i))
+                {
+                    if (final)
+                        emit(i, offset);
+                    offset += 1;
+                } }, count);
+        return count;
+    }
+
+    // Copies the elements of in satisfying pred to the front of out, keeping their order
+    template <class InView, class OutView, class Pred>
+    std::int64_t compact(const InView &in, const OutView &out, const Pred &pred)
+    {
+        using exec = typename InView::execution_space;
+        return select<exec>(
+            "compact::compact", static_cast<std::int64_t>(in.extent(0)),
+            KOKKOS_LAMBDA(std::int64_t i) { return pred(in(i)); },
+            KOKKOS_LAMBDA(std::int64_t i, std::int64_t pos) { out(pos) = in(i); });
+    }
+
+    // Writes the indices (not the values) of the elements satisfying pred
+    template <class InView, class IndexView, class Pred>
+    std::int64_t compact_indices(const InView &in, const IndexView &indices, const Pred &pred)
+    {
+        using exec = typename InView::execution_space;
+        using index_type = typename IndexView::non_const_value_type;
+        return select<exec>(
+            "compact::compact_indices", static_cast<std::int64_t>(in.extent(0)),
+            KOKKOS_LAMBDA(std::int64_t i) { return pred(in(i)); },
+            KOKKOS_LAMBDA(std::int64_t i, std::int64_t pos) { indices(pos) = static_cast<index_type>(i); });
+    }
+
+    // Stable partition: elements satisfying pred first, then the others, both in their original order
+    // The rejected elements start at the selected count, which a scan only knows at the end,
+    // so the count is reduced first (predicate fused, nothing stored) and a single scan scatters both sides.
+    template <class InView, class OutView, class Pred>
+    std::int64_t partition(const InView &in, const OutView &out, const Pred &pred)
+    {
+        using exec = typename InView::execution_space;
+        const std::int64_t n = static_cast<std::int64_t>(in.extent(0));
+        std::int64_t selected = 0;
+        Kokkos::parallel_reduce("compact::partition_count", Kokkos::RangePolicy<exec>(0, n), KOKKOS_LAMBDA(std::int64_t i, std::int64_t &update) { update += pred(in(i)) ? 1 : 0; }, selected);
+
+        std::int64_t total = 0;
+        Kokkos::parallel_scan("compact::partition", Kokkos::RangePolicy<exec>(0, n), KOKKOS_LAMBDA(std::int64_t i, std::int64_t &offset, bool final) {
+                const bool keep = pred(in(i));
+                if (final)
+                    out(keep ? offset : selected + (i - offset)) = in(i);
+                offset += keep ? 1 : 0; }, total);
+        return selected;
+    }
+
+    // Removes consecutive duplicates like std::unique, the survivors go to the front of out
+    template <class InView, class OutView>
+    std::int64_t unique(const InView &in, const OutView &out)
+    {
+        using exec = typename InView::execution_space;
+        return select<exec>(
+            "compact::unique", static_cast<std::int64_t>(in.extent(0)),
+            KOKKOS_LAMBDA(std::int64_t i) { return i == 0 || !(in(i) == in(i - 1)); },
+            KOKKOS_LAMBDA(std::int64_t i, std::int64_t pos) { out(pos) = in(i); });
+    }
+}
@@ -0,0 +1,166 @@
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include "benchmark.hpp"
+#include "kokkos-expressions.hpp"
+#include "kokkos-random.hpp"
+
+// Fused expression kernels against the multi-kernel sequences of kokkos-parallel-patterns.cpp
+// The bytes of each benchmark are the memory traffic of that version (8 bytes per double
+// read or written), so the GB/s column compares effective bandwidth and the time column
+// shows what removing the intermediate Views saves.
+// Usage: ./kokkos-expressions [--kokkos-num-threads=T] [--json file]
+
+using namespace expr;
+
+bool check(const char *what, double got, double expected)
+{
+    double err = std::abs(got - expected) / std::max(1.0, std::abs(expected));
+    bool ok = err <= 1e-12;
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << ": " << got << " (reference " << expected << ")\n";
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    const int n = 1 << 24;
+    const int rows = 2048, cols = 2048;
+    Kokkos::View<double *> a("a", n), b("b", n), tmp("tmp", n);
+    Kokkos::View<double **> A("A", rows, cols), B("B", rows, cols), C("C", rows, cols);
+    random_fill::Filler<> random(2024);
+    random.uniform(a, -1.0, 1.0);
+    random.uniform(b, -1.0, 1.0);
+    random.uniform(A, -1.0, 1.0);
+    random.uniform(B, -1.0, 1.0);
+
+    // Verification against host loops
+    std::cout << "\n=== Verification ===\n";
+    bool ok = true;
+    auto a_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), a);
+    auto b_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), b);
+    auto A_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A);
+    auto B_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B);
+
+    double ref_dot = 0, ref_axpy_dot = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        ref_dot += a_host(i) * b_host(i);
+        ref_axpy_dot += (a_host(i) + 2.8 * b_host(i)) * a_host(i);
+    }
+    double ref_frobenius = 0, ref_index = 0;
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j)
+        {
+            double c = A_host(i, j) + B_host(i, j);
+            ref_frobenius += c * c;
+            ref_index += (i + j) * A_host(i, j);
+        }
+
+    ok &= check("dot(a, b)", dot(a, b), ref_dot);
+    ok &= check("dot(a + 2.8 * b, a)", dot(a + 2.8 * b, a), ref_axpy_dot);
+    ok &= check("norm2(A + B)", norm2(A + B), std::sqrt(ref_frobenius));
+    ok &= check("sum((index<0> + index<1>) * A)", sum((index<0>() + index<1>()) * A), ref_index);
+
+    assign(C, A + B);
+    auto C_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), C);
+    double max_err = 0;
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j)
+            max_err = std::max(max_err, std::abs(C_host(i, j) - (A_host(i, j) + B_host(i, j))));
+    ok &= check("assign(C, A + B) max error", max_err, 0.0);
+
+    assign(tmp, 2.8 * a - b / 2.0);
+    auto tmp_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), tmp);
+    max_err = 0;
+    for (int i = 0; i < n; ++i)
+        max_err = std::max(max_err, std::abs(tmp_host(i) - (2.8 * a_host(i) - b_host(i) / 2.0)));
+    ok &= check("assign(tmp, 2.8 * a - b / 2) max error", max_err, 0.0);
+
+    // Operands and destinations of different extents are rejected before any kernel runs
+    Kokkos::View<double *> shorter("shorter", n - 1);
+    int rejected = 0;
+    try
+    {
+        (void)dot(a, shorter);
+    }
+    catch (const std::invalid_argument &)
+    {
+        ++rejected;
+    }
+    try
+    {
+        assign(shorter, a + b);
+    }
+    catch (const std::invalid_argument &)
+    {
+        ++rejected;
+    }
+    std::cout << (rejected == 2 ? "[PASS] " : "[FAIL] ") << "mismatched extents throw std::invalid_argument\n";
+    ok &= rejected == 2;
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const double word = sizeof(double);
+    const double N = double(rows) * cols;
+
+    // Part 2: C = A + B, then a separate Frobenius reduce reading C back (read 2, write 1, read 1)
+    runner.run(
+        "frobenius(A+B) two kernels", [&]()
+        {
+        Kokkos::parallel_for("C=A+B", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {rows, cols}), KOKKOS_LAMBDA(int i, int j) { C(i, j) = A(i, j) + B(i, j); });
+        double s = 0;
+        Kokkos::parallel_reduce("Frobenius_C", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {rows, cols}), KOKKOS_LAMBDA(int i, int j, double &update) { update += C(i, j) * C(i, j); }, s);
+        bench::DoNotOptimize(s); },
+        4 * N * word);
+    runner.run(
+        "frobenius(A+B) fused norm2", [&]()
+        { bench::DoNotOptimize(norm2(A + B)); },
+        2 * N * word);
+
+    // Scale: the same single kernel either way, the expression layer should cost nothing
+    runner.run(
+        "b = 2.8*a lambda", [&]()
+        {
+        Kokkos::parallel_for("scale", n, KOKKOS_LAMBDA(int i) { tmp(i) = 2.8 * a(i); });
+        Kokkos::fence(); },
+        2 * n * word);
+    runner.run(
+        "b = 2.8*a assign", [&]()
+        { assign(tmp, 2.8 * a); Kokkos::fence(); },
+        2 * n * word);
+
+    // Dot: hand-written reduce against the expression
+    runner.run(
+        "dot(a,b) lambda", [&]()
+        {
+        double s = 0;
+        Kokkos::parallel_reduce("dot_a_b", n, KOKKOS_LAMBDA(int i, double &update) { update += a(i) * b(i); }, s);
+        bench::DoNotOptimize(s); },
+        2 * n * word);
+    runner.run(
+        "dot(a,b) expr", [&]()
+        { bench::DoNotOptimize(dot(a, b)); },
+        2 * n * word);
+
+    // tmp = a + 2.8 b, then dot(tmp, a) (read 2, write 1, read 2) against one fused reduce (read 2)
+    runner.run(
+        "dot(a+2.8b,a) two kernels", [&]()
+        {
+        Kokkos::parallel_for("axpy", n, KOKKOS_LAMBDA(int i) { tmp(i) = a(i) + 2.8 * b(i); });
+        double s = 0;
+        Kokkos::parallel_reduce("dot_tmp_a", n, KOKKOS_LAMBDA(int i, double &update) { update += tmp(i) * a(i); }, s);
+        bench::DoNotOptimize(s); },
+        5 * n * word);
+    runner.run(
+        "dot(a+2.8b,a) fused", [&]()
+        { bench::DoNotOptimize(dot(a + 2.8 * b, a)); },
+        2 * n * word);
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Lazy, fused arithmetic on rank 1 / rank 2 Kokkos Views (expression templates)
+// Operators on Views, scalars and index placeholders only build a small expression type;
+// nothing runs until the whole expression is assigned or reduced, and then it runs as a
+// single kernel reading each input once, without temporary Views.
+//
+//   using namespace expr;
+//   assign(C, A + B);             // one parallel_for, no temporary
+//   assign(b, 2.8 * a);
+//   double d = dot(a, b);         // one parallel_reduce
+//   double f = norm2(A + B);      // Frobenius norm of A + B, C is never written
+//   assign(A, index<0>() + index<1>()); // A(i, j) = i + j
+//
+// The operators are found through `using namespace expr` (or expr::operator+ ...), they do not
+// change the meaning of any expression that does not involve expr types or Views.
+// Operands with extents must agree on every extent, and so must the destination of assign;
+// a mismatch throws std::invalid_argument when the expression is built or assigned.
+namespace expr
+{
+    // Every node has expr_tag, rank (0 for broadcast operands), sized (knows its extents),
+    // execution_space (of its first View operand, void without one), operator()(i) and operator()(i, j)
+    template <class T>
+    concept expression = requires { typename T::expr_tag; };
+
+    template <class T>
+    concept view = Kokkos::is_view<T>::value;
+
+    template <class T>
+    concept operand = expression<T> || view<T> || std::is_arithmetic_v<T>;
+
+    template <class V>
+    struct Terminal
+    {
+        using expr_tag = void;
+        static constexpr int rank = V::rank;
+        static constexpr bool sized = true;
+        using execution_space = typename V::execution_space;
+        V v;
+
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i) const { return v(i); }
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i, std::int64_t j) const { return v(i, j); }
+        std::int64_t extent(int r) const { return static_cast<std::int64_t>(v.extent(r)); }
+    };
+
+    template <class T>
+    struct Scalar
+    {
+        using expr_tag = void;
+        static constexpr int rank = 0;
+        static constexpr bool sized = false;
+        using execution_space = void;
+        T value;
+
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t) const { return value; }
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t, std::int64_t) const { return value; }
+        std::int64_t extent(int) const { return 0; }
+    };
+
+    // The loop index along dimension Dim, as a value
+    template <int Dim>
+    struct Index
+    {
+        using expr_tag = void;
+        static constexpr int rank = 0;
+        static constexpr bool sized = false;
+        using execution_space = void;
+
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i) const { return static_cast<double>(i); }
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i, std::int64_t j) const { return static_cast<double>(Dim == 0 ? i : j); }
+        std::int64_t extent(int) const { return 0; }
+    };
+
+    template <int Dim = 0>
+    Index<Dim> index() { return {}; }
+
+    struct Add
+    {
+        KOKKOS_INLINE_FUNCTION static double apply(double a, double b) { return a + b; }
+    };
+    struct Sub
+    {
+        KOKKOS_INLINE_FUNCTION static double apply(double a, double b) { return a - b; }
+    };
+    struct Mul
+    {
+        KOKKOS_INLINE_FUNCTION static double apply(double a, double b) { return a * b; }
+    };
+    struct Div
+    {
+        KOKKOS_INLINE_FUNCTION static double apply(double a, double b) { return a / b; }
+    };
+
+    template <class Op, class L, class R>
+    struct Binary
+    {
+        using expr_tag = void;
+        static constexpr int rank = L::rank > R::rank ? L::rank : R::rank;
+        static constexpr bool sized = L::sized || R::sized;
+        using execution_space = std::conditional_t<L::sized, typename L::execution_space, typename R::execution_space>;
+        L l;
+        R r;
+
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i) const { return Op::apply(l(i), r(i)); }
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i, std::int64_t j) const { return Op::apply(l(i, j), r(i, j)); }
+        std::int64_t extent(int d) const
+        {
+            if constexpr (L::sized)
+                return l.extent(d);
+            else
+                return r.extent(d);
+        }
+    };
+
+    template <class E>
+    struct Negate
+    {
+        using expr_tag = void;
+        static constexpr int rank = E::rank;
+        static constexpr bool sized = E::sized;
+        using execution_space = typename E::execution_space;
+        E e;
+
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i) const { return -e(i); }
+        KOKKOS_INLINE_FUNCTION double operator()(std::int64_t i, std::int64_t j) const { return -e(i, j); }
+        std::int64_t extent(int d) const { return e.extent(d); }
+    };
+
+    // View -> Terminal, scalar -> Scalar, expressions unchanged
+    template <operand T>
+    auto wrap(const T &x)
+    {
+        if constexpr (expression<T>)
+            return x;
+        else if constexpr (view<T>)
+            return Terminal<T>{x};
+        else
+            return Scalar<double>{static_cast<double>(x)};
+    }
+
+    // At least one side must be an expression or a View, so plain arithmetic is untouched
+    template <class L, class R>
+    concept binary_operands = operand<L> && operand<R> && !(std::is_arithmetic_v<L> && std::is_arithmetic_v<R>);
+
+    // Throws unless a and b have the same extents (rank of a), when both know them
+    template <class A, class B>
+    void check_extents(const char *what, const A &a, const B &b)
+    {
+        if constexpr (A::sized && B::sized)
+            for (int d = 0; d < A::rank; ++d)
+                if (a.extent(d) != b.extent(d))
+                    throw std::invalid_argument(std::string(what) + ": extent " + std::to_string(d) + " is " +
+                                                std::to_string(a.extent(d)) + " on one side and " + std::to_string(b.extent(d)) + " on the other");
+    }
+
+    template <class Op, class L, class R>
+    auto make_binary(const L &l, const R &r)
+    {
+        using WL = decltype(wrap(l));
+        using WR = decltype(wrap(r));
+        static_assert(WL::rank == 0 || WR::rank == 0 || WL::rank == WR::rank, "operands must have the same rank");
+        Binary<Op, WL, WR> b{wrap(l), wrap(r)};
+        check_extents("expr", b.l, b.r);
+        return b;
+    }
+
+    template <class L, class R>
+        requires binary_operands<L, R>
+    auto operator+(const L &l, const R &r) { return make_binary<Add>(l, r); }
+
+    template <class L, class R>
+        requires binary_operands<L, R>
+    auto operator-(const L &l, const R &r) { return make_binary<Sub>(l, r); }
+
+    template <class L, class R>
+        requires binary_operands<L, R>
+    auto operator*(const L &l, const R &r) { return make_binary<Mul>(l, r); }
+
+    template <class L, class R>
+        requires binary_operands<L, R>
+    auto operator/(const L &l, const R &r) { return make_binary<Div>(l, r); }
+
+    template <class E>
+        requires(expression<E> || view<E>)
+    auto operator-(const E &e) { return Negate<decltype(wrap(e))>{wrap(e)}; }
+
+    // dst(i...) = e(i...) in one parallel_for over the extents of dst
+    template <class View, operand E>
+    void assign(const View &dst, const E &e)
+    {
+        using exec = typename View::execution_space;
+        const auto x = wrap(e);
+        static_assert(View::rank == 1 || View::rank == 2, "expr supports rank 1 and 2 Views");
+        static_assert(decltype(x)::rank == 0 || decltype(x)::rank == View::rank, "expression and destination must have the same rank");
+        check_extents("expr::assign", Terminal<View>{dst}, x);
+        if constexpr (View::rank == 1)
+            Kokkos::parallel_for("expr::assign", Kokkos::RangePolicy<exec>(0, dst.extent(0)), KOKKOS_LAMBDA(std::int64_t i) { dst(i) = x(i); });
+        else
+            Kokkos::parallel_for("expr::assign", Kokkos::MDRangePolicy<exec, Kokkos::Rank<2>>({0, 0}, {static_cast<std::int64_t>(dst.extent(0)), static_cast<std::int64_t>(dst.extent(1))}), KOKKOS_LAMBDA(std::int64_t i, std::int64_t j) { dst(i, j) = x(i, j); });
+    }
+
+    struct Identity
+    {
+        KOKKOS_INLINE_FUNCTION static double apply(double x) { return x; }
+    };
+    struct Square
+    {
+        KOKKOS_INLINE_FUNCTION static double apply(double x) { return x * x; }
+    };
+
+    // Sum of F::apply(e(i...)) over all elements, in one parallel_reduce on the execution space
+    // of the first View operand (as assign runs on the one of its destination)
+    template <class F, class E>
+    double reduce_sum(const char *label, const E &e)
+    {
+        static_assert(E::sized, "a reduction needs at least one View operand to know its extents");
+        using exec = typename E::execution_space;
+        double result = 0.0;
+        if constexpr (E::rank == 1)
+            Kokkos::parallel_reduce(label, Kokkos::RangePolicy<exec>(0, e.extent(0)), KOKKOS_LAMBDA(std::int64_t i, double &update) { update += F::apply(e(i)); }, result);
+        else
+            Kokkos::parallel_reduce(label, Kokkos::MDRangePolicy<exec, Kokkos::Rank<2>>({0, 0}, {e.extent(0), e.extent(1)}), KOKKOS_LAMBDA(std::int64_t i, std::int64_t j, double &update) { update += F::apply(e(i, j)); }, result);
+        return result;
+    }
+
+    template <operand E>
+    double sum(const E &e) { return reduce_sum<Identity>("expr::sum", wrap(e)); }
+
+    template <operand A, operand B>
+    double dot(const A &a, const B &b) { return reduce_sum<Identity>("expr::dot", make_binary<Mul>(a, b)); }
+
+    // Euclidean norm for rank 1, Frobenius norm for rank 2
+    template <operand E>
+    double norm2(const E &e) { return Kokkos::sqrt(reduce_sum<Square>("expr::norm2", wrap(e))); }
+}
@@ -0,0 +1,125 @@
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "kokkos-gemm.hpp"
+#include "kokkos-random.hpp"
+
+// GFLOP/s of the tiled TeamPolicy GEMM against the naive MDRange triple loop,
+// for LayoutRight and LayoutLeft operands
+// Usage: ./kokkos-gemm [--size N]... [--kokkos-num-threads=T] [--json file]
+//   --size may be repeated, e.g. --size 1024 --size 2048 --size 4096 (default 512 and 1024)
+// Every result is checked against a serial dot product on sampled entries of C,
+// a full serial reference would cost as much as the benchmark itself.
+
+std::vector<int> parse_sizes(int argc, char *argv[])
+{
+    std::vector<int> sizes;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--size")
+            sizes.push_back(std::atoi(argv[i + 1]));
+    if (sizes.empty())
+        sizes = {512, 1024};
+    return sizes;
+}
+
+// Largest relative error of C over sampled (i, j) against a serial dot product
+template <class ViewA, class ViewB, class ViewC>
+double max_sampled_error(const ViewA &A, const ViewB &B, const ViewC &C)
+{
+    auto a = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A);
+    auto b = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B);
+    auto c = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), C);
+    const int M = static_cast<int>(C.extent(0));
+    const int N = static_cast<int>(C.extent(1));
+    const int K = static_cast<int>(A.extent(1));
+    double worst = 0.0;
+    std::uint64_t state = 42;
+    for (int s = 0; s < 256; ++s)
+    {
+        // Corners and edges of the tiles are where padding bugs show up, so always include them
+        state = random_fill::mix(state);
+        int i = s < 4 ? (s & 1) * (M - 1) : static_cast<int>(state % M);
+        int j = s < 4 ? (s >> 1) * (N - 1) : static_cast<int>((state >> 32) % N);
+        double ref = 0.0;
+        for (int k = 0; k < K; ++k)
+            ref += a(i, k) * b(k, j);
+        worst = std::max(worst, std::abs(c(i, j) - ref) / std::max(1.0, std::abs(ref)));
+    }
+    return worst;
+}
+
+const bench::Result *find_result(const bench::Runner &runner, const std::string &name)
+{
+    for (const auto &r : runner.results())
+        if (r.name == name)
+            return &r;
+    return nullptr; // filtered out
+}
+
+template <class Layout>
+bool run_layout(bench::Runner &runner, const char *layout_name, int n)
+{
+    using matrix = Kokkos::View<double **, Layout>;
+    // Non-tile-multiple extents so the edge tiles are exercised
+    const int M = n, N = n + 3, K = n + 1;
+    matrix A("A", M, K), B("B", K, N), C("C", M, N);
+    random_fill::Filler<> random(2024);
+    random.uniform(A, -1.0, 1.0);
+    random.uniform(B, -1.0, 1.0);
+
+    const double flops = 2.0 * M * N * K;
+    const std::string suffix = std::string(" ") + layout_name + " " + std::to_string(n);
+    bool ok = true;
+
+    auto check = [&](const char *name)
+    {
+        double err = max_sampled_error(A, B, C);
+        bool pass = err < 1e-12;
+        std::cout << (pass ? "[PASS] " : "[FAIL] ") << name << suffix << ": max relative error " << err << "\n";
+        ok &= pass;
+    };
+
+    gemm::naive(A, B, C);
+    Kokkos::fence();
+    check("naive");
+    runner.run("gemm naive" + suffix, [&]()
+               { gemm::naive(A, B, C); Kokkos::fence(); });
+
+    Kokkos::deep_copy(C, 0.0);
+    gemm::tiled(A, B, C);
+    Kokkos::fence();
+    check("tiled");
+    runner.run("gemm tiled" + suffix, [&]()
+               { gemm::tiled(A, B, C); Kokkos::fence(); });
+
+    const bench::Result *naive = find_result(runner, "gemm naive" + suffix);
+    const bench::Result *tiled = find_result(runner, "gemm tiled" + suffix);
+    if (naive && tiled)
+        std::cout << "  " << layout_name << " " << n << ": naive " << flops / naive->median_ns << " GFLOP/s, tiled "
+                  << flops / tiled->median_ns << " GFLOP/s (" << naive->median_ns / tiled->median_ns << "x)\n";
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    bool ok = true;
+    for (int n : parse_sizes(argc, argv))
+    {
+        ok &= run_layout<Kokkos::LayoutRight>(runner, "LayoutRight", n);
+        ok &= run_layout<Kokkos::LayoutLeft>(runner, "LayoutLeft", n);
+    }
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <type_traits>
+
+// Dense matrix multiply C = A * B on Kokkos Views
+// - naive: MDRangePolicy over (i, j), k loop in the kernel (the Part 2 pattern of kokkos-parallel-patterns.cpp)
+// - tiled: one team per TM x TN tile of C; the team stages TM x TK tiles of A and TK x TN tiles of B
+//   in scratch memory, each thread owns RM rows of the C tile and keeps them in registers while
+//   the vector lanes (ThreadVectorRange) sweep the columns
+// A, B and C may each be LayoutLeft or LayoutRight; tiles are copied in the order that reads
+// the source contiguously, so the kernel itself only ever sees LayoutRight scratch tiles.
+namespace gemm
+{
+    template <class ViewA, class ViewB, class ViewC>
+    void naive(const ViewA &A, const ViewB &B, const ViewC &C)
+    {
+        using exec = typename ViewC::execution_space;
+        const int M = static_cast<int>(C.extent(0));
+        const int N = static_cast<int>(C.extent(1));
+        const int K = static_cast<int>(A.extent(1));
+        Kokkos::parallel_for("gemm_naive", Kokkos::MDRangePolicy<exec, Kokkos::Rank<2>>({0, 0}, {M, N}), KOKKOS_LAMBDA(int i, int j) {
+            double sum = 0.0;
+            for (int k = 0; k < K; ++k)
+                sum += A(i, k) * B(k, j);
+            C(i, j) = sum; });
+    }
+
+    template <class View>
+    constexpr bool is_layout_left = std::is_same_v<typename View::array_layout, Kokkos::LayoutLeft>;
+
+    template <int TM = 64, int TN = 64, int TK = 32, int RM = 4>
+    struct Tiled
+    {
+        static_assert(TM % RM == 0, "row block must divide the tile height");
+
+        template <class ViewA, class ViewB, class ViewC>
+        static void run(const ViewA &A, const ViewB &B, const ViewC &C)
+        {
+            using exec = typename ViewC::execution_space;
+            using policy = Kokkos::TeamPolicy<exec>;
+            using member = typename policy::member_type;
+            using scratch = Kokkos::View<double **, Kokkos::LayoutRight, typename exec::scratch_memory_space, Kokkos::MemoryUnmanaged>;
+
+            const int M = static_cast<int>(C.extent(0));
+            const int N = static_cast<int>(C.extent(1));
+            const int K = static_cast<int>(A.extent(1));
+            const int tiles_m = (M + TM - 1) / TM;
+            const int tiles_n = (N + TN - 1) / TN;
+            const std::size_t bytes = scratch::shmem_size(TM, TK) + scratch::shmem_size(TK, TN) + scratch::shmem_size(TM, TN);
+
+            Kokkos::parallel_for(
+                "gemm_tiled", policy(tiles_m * tiles_n, Kokkos::AUTO).set_scratch_size(0, Kokkos::PerTeam(bytes)), KOKKOS_LAMBDA(const member &team) {
+                    const int i0 = (team.league_rank() / tiles_n) * TM;
+                    const int j0 = (team.league_rank() % tiles_n) * TN;
+                    scratch As(team.team_scratch(0), TM, TK);
+                    scratch Bs(team.team_scratch(0), TK, TN);
+                    scratch Cs(team.team_scratch(0), TM, TN);
+
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, TM), [&](int r) {
+                        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, TN), [&](int c) { Cs(r, c) = 0.0; }); });
+
+                    for (int k0 = 0; k0 < K; k0 += TK)
+                    {
+                        team.team_barrier();
+                        load_tile(team, A, As, i0, k0);
+                        load_tile(team, B, Bs, k0, j0);
+                        team.team_barrier();
+
+                        // RM rows of C per thread, in registers across the TK loop
+                        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, TM / RM), [&](int rb) {
+                            const int r0 = rb * RM;
+                            Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, TN), [&](int c) {
+                                double acc[RM];
+                                for (int r = 0; r < RM; ++r)
+                                    acc[r] = Cs(r0 + r, c);
+                                for (int kk = 0; kk < TK; ++kk)
+                                {
+                                    const double b = Bs(kk, c);
+                                    for (int r = 0; r < RM; ++r)
+                                        acc[r] += As(r0 + r, kk) * b;
+                                }
+                                for (int r = 0; r < RM; ++r)
+                                    Cs(r0 + r, c) = acc[r]; }); });
+                    }
+                    team.team_barrier();
+                    store_tile(team, Cs, C, i0, j0); });
+        }
+
+        // Copies src(row0 + r, col0 + c) into the scratch tile, zero-padding past the edges
+        // The vector loop runs along the contiguous dimension of src
+        template <class Member, class Src, class Tile>
+        KOKKOS_INLINE_FUNCTION static void load_tile(const Member &team, const Src &src, const Tile &tile, int row0, int col0)
+        {
+            const int rows = static_cast<int>(tile.extent(0));
+            const int cols = static_cast<int>(tile.extent(1));
+            const int src_rows = static_cast<int>(src.extent(0));
+            const int src_cols = static_cast<int>(src.extent(1));
+            if constexpr (is_layout_left<Src>)
+            {
+                Kokkos::parallel_for(Kokkos::TeamThreadRange(team, cols), [&](int c) {
+                    Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, rows), [&](int r) {
+                        const int i = row0 + r, j = col0 + c;
+                        tile(r, c) = (i < src_rows && j < src_cols) ? src(i, j) : 0.0; }); });
+            }
+            else
+            {
+                Kokkos::parallel_for(Kokkos::TeamThreadRange(team, rows), [&](int r) {
+                    Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, cols), [&](int c) {
+                        const int i = row0 + r, j = col0 + c;
+                        tile(r, c) = (i < src_rows && j < src_cols) ? src(i, j) : 0.0; }); });
+            }
+        }
+
+        template <class Member, class Tile, class Dst>
+        KOKKOS_INLINE_FUNCTION static void store_tile(const Member &team, const Tile &tile, const Dst &dst, int row0, int col0)
+        {
+            const int rows = static_cast<int>(dst.extent(0)) - row0 < TM ? static_cast<int>(dst.extent(0)) - row0 : TM;
+            const int cols = static_cast<int>(dst.extent(1)) - col0 < TN ? static_cast<int>(dst.extent(1)) - col0 : TN;
+            if constexpr (is_layout_left<Dst>)
+            {
+                Kokkos::parallel_for(Kokkos::TeamThreadRange(team, cols), [&](int c) {
+                    Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, rows), [&](int r) { dst(row0 + r, col0 + c) = tile(r, c); }); });
+            }
+            else
+            {
+                Kokkos::parallel_for(Kokkos::TeamThreadRange(team, rows), [&](int r) {
+                    Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, cols), [&](int c) { dst(row0 + r, col0 + c) = tile(r, c); }); });
+            }
+        }
+    };
+
+    template <class ViewA, class ViewB, class ViewC>
+    void tiled(const ViewA &A, const ViewB &B, const ViewC &C)
+    {
+        Tiled<>::run(A, B, C);
+    }
+}
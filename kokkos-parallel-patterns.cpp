@@ -1,42 +1,19 @@
 #include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <thread>
 
-class TimerGuard
-{
-private:
-    std::string description_;
-    std::chrono::time_point<std::chrono::high_resolution_clock> start_;
-
-public:
-    explicit TimerGuard(const std::string &description)
-        : description_(description),
-          start_(std::chrono::high_resolution_clock::now())
-    {
-        std::cout << "[TIMER] Starting: " << description_ << '\n';
-    }
-
-    ~TimerGuard()
-    {
-        auto end_ = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = end_ - start_;
-        std::cout << "[TIMER]: " << description_ << " took " << elapsed.count() << " second \n";
-    }
-
-    TimerGuard(const TimerGuard &timer) = delete;
-    TimerGuard &operator=(const TimerGuard &timer) = delete;
-};
-
-struct Stats
-{
-    double sum;
-    double min;
-    double max;
-    int count;
-};
+#include "kokkos-compact.hpp"
+#include "kokkos-random.hpp"
+#include "kokkos-reducers.hpp"
+#include "kokkos-selection.hpp"
+#include "kokkos-simd-reductions.hpp"
+#include "kokkos-tools-connector.hpp"
+#include "profiler.hpp"
 
 struct MinMaxLoc
 {
@@ -52,6 +29,10 @@ int main(int argc, char *argv[])
     Kokkos::ScopeGuard guard(argc, argv);
     std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name() << "\n";
 
+    // Per-label kernel/deep_copy/allocation report at finalize, unless a tool library is already loaded
+    if (!std::getenv("KOKKOS_TOOLS_LIBS"))
+        kokkos_connector::register_callbacks();
+
     // parallel_for
     // - Kokkos::RangePolicy<`ExecutionSpace`, Kokkos::Rank<n>>({startRange.dim0, startRange.dim1,...},{endRange.dim0,endRange.dim1,...}).set_chunk_size(`integer you may want`)
     // Use labels in parallel nests !
@@ -62,16 +43,15 @@ int main(int argc, char *argv[])
     // Part 1: Vector Operations with parallel_reduce
     Kokkos::View<double *> vector("vector_reduce", 1000);
 
-    Kokkos::parallel_for("filling vector_reduce", 1000, KOKKOS_LAMBDA(int i) { vector(i) = rand() / double(RAND_MAX); });
+    // One seeded generator per block instead of rand(), which serializes (or races) inside kernels
+    random_fill::Filler<> random(2024);
+    random.uniform(vector, 0.0, 1.0);
 
-    Stats myStats{0.0, 1e100, -1e100, 0};
-    Kokkos::parallel_reduce("reduce vector_reduce", 1000, KOKKOS_LAMBDA(int i, Stats &tempStats) {
-        if (vector(i) < tempStats.min) {tempStats.min = vector(i);}
-        if (vector(i) > tempStats.max) {tempStats.max = vector(i);}
-        if (vector(i) > 0.5) {tempStats.count += 1;}
-            tempStats.sum += vector(i); }, myStats);
+    // reducers::Stats initializes every partial (min = +inf, max = -inf) and joins them, on any backend
+    reducers::StatsValue myStats;
+    Kokkos::parallel_reduce("reduce vector_reduce", 1000, KOKKOS_LAMBDA(int i, reducers::StatsValue &tempStats) { tempStats.add(vector(i), 0.5); }, reducers::Stats<>(myStats));
 
-    std::cout << "vector_reduce: \nsum = " << myStats.sum << "\nmin = " << myStats.min << "\nmax = " << myStats.max << "\ncount = " << myStats.count << "\naverage = " << myStats.sum / 1000 << "\n";
+    std::cout << "vector_reduce: \nsum = " << myStats.sum << "\nmin = " << myStats.min << "\nmax = " << myStats.max << "\ncount = " << myStats.count_above << "\naverage = " << myStats.sum / 1000 << "\n";
 
     // Part 2: Matrix Operations with MDRangePolicy
     Kokkos::View<double **> A("A", 100, 100);
@@ -106,38 +86,37 @@ int main(int argc, char *argv[])
     std::cout << "Frobenius norm of C " << norm << " " << sum << "\n";
 
     // Part 3: Prefix Sum Application
+    // compact::compact evaluates the predicate inside parallel_scan and scatters in its final pass,
+    // the selected count is the scan total (no flag array, no read-back of the last offset)
     Kokkos::View<int *> array("random_int", 10);
-    Kokkos::View<int *> flag("flag", 10);
-    Kokkos::View<int *> scan("scan", 10);
-    Kokkos::deep_copy(flag, 0);
-    Kokkos::parallel_for("filling_array", 10, KOKKOS_LAMBDA(int i) { 
-        array(i) = (int)rand() / abs(int(RAND_MAX)/10); 
-        if(array(i) > 5) flag(i) = 1; });
+    Kokkos::View<int *> selected("selected", 10);
+    Kokkos::View<int *> partitioned("partitioned", 10);
+    random.integer(array, 0, 10);
+    auto greater_than_5 = KOKKOS_LAMBDA(int v) { return v > 5; };
 
-    Kokkos::parallel_scan("generate_index", 10, KOKKOS_LAMBDA(int i, int &update, bool final) {
-        if(flag(i)) update++;    
-        if(final) scan(i) = update; });
+    std::int64_t count = compact::compact(array, selected, greater_than_5);
+    compact::partition(array, partitioned, greater_than_5);
 
     auto array_host = Kokkos::create_mirror_view(array);
     Kokkos::deep_copy(array_host, array);
-    auto flag_host = Kokkos::create_mirror_view(flag);
-    Kokkos::deep_copy(flag_host, flag);
-    auto scan_host = Kokkos::create_mirror_view(scan);
-    Kokkos::deep_copy(scan_host, scan);
+    auto selected_host = Kokkos::create_mirror_view(selected);
+    Kokkos::deep_copy(selected_host, selected);
+    auto partitioned_host = Kokkos::create_mirror_view(partitioned);
+    Kokkos::deep_copy(partitioned_host, partitioned);
 
     std::cout << "Array: ";
     for (int i = 0; i < 10; i++)
         std::cout << array_host(i) << " ";
     std::cout << "\n";
 
-    std::cout << "Flag: ";
-    for (int i = 0; i < 10; i++)
-        std::cout << flag_host(i) << " ";
+    std::cout << "Selected (> 5, " << count << "): ";
+    for (int i = 0; i < count; i++)
+        std::cout << selected_host(i) << " ";
     std::cout << "\n";
 
-    std::cout << "Scan: ";
+    std::cout << "Partitioned: ";
     for (int i = 0; i < 10; i++)
-        std::cout << scan_host(i) << " ";
+        std::cout << partitioned_host(i) << " ";
     std::cout << "\n";
 
     // Part 4: Dot Product (Production Version)
@@ -150,16 +129,18 @@ int main(int argc, char *argv[])
 
     double dot = 0;
     {
-        TimerGuard("Dot Product");
+        TimerGuard timer("Dot Product");
         Kokkos::parallel_reduce("dot_a_b", n, KOKKOS_LAMBDA(int i, double &tempDot) { tempDot += double(a(i)) * double(b(i)); }, dot);
         Kokkos::fence();
     }
     std::cout << "Dot Product a*b = " << dot << "\n";
+    // Same dot product with SIMD lanes and compensated summation, reproducible for any thread count
+    std::cout << "Compensated Dot Product a*b = " << simd_reduce::dot(a, b) << "\n";
 
     // Part 5: Finding Extrema with Location
     const int n_extrema = 100;
     Kokkos::View<double *> extrema("extrema", n_extrema);
-    Kokkos::parallel_for("filling_extrema", n_extrema, KOKKOS_LAMBDA(int i) { extrema(i) = rand() / (double(RAND_MAX) / 100); });
+    random.uniform(extrema, 0.0, 100.0);
     // MinMaxLoc myExtrema{1e100, 0, -1e100, 0};
     Kokkos::MinMaxLoc<double, int>::value_type result;
 
@@ -181,5 +162,12 @@ int main(int argc, char *argv[])
     std::cout << "Extrema_host[max_loc] = " << extrema_host(result.max_loc) << "\n";
     std::cout << "Extrema_host[min_loc] = " << extrema_host(result.min_loc) << "\n";
 
+    // Beyond one min / max: the 3 largest values with their positions, and the median
+    auto top = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), selection::top_k(extrema, 3));
+    std::cout << "Top 3:";
+    for (int j = 0; j < 3; j++)
+        std::cout << " " << top(j).value << " (position " << top(j).index << ")";
+    std::cout << "\nMedian = " << selection::quantile(extrema, 0.5) << "\n";
+
     return 0;
 }
\ No newline at end of file
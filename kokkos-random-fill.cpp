@@ -0,0 +1,68 @@
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "kokkos-random.hpp"
+
+// Fill throughput of the random_fill module against the rand() fill of kokkos-parallel-patterns.cpp
+// Run once per thread count to get the scaling, e.g.
+//   for t in 1 2 4 8; do ./kokkos-random-fill --kokkos-num-threads=$t --json fill-$t.json; done
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    const int n = 1 << 23;
+    Kokkos::View<double *> x("x", n);
+    Kokkos::View<double *> y("y", n);
+    Kokkos::View<double **> m("m", 2048, 2048);
+    Kokkos::View<int *> k("k", n);
+
+    // Reproducibility: the reproducible stream gives the same values on every run and thread count
+    random_fill::Filler<> filler(2024);
+    filler.uniform(x, 0.0, 1.0);
+    filler.uniform(y, 0.0, 1.0);
+    std::int64_t mismatches = 0;
+    Kokkos::parallel_reduce("compare", n, KOKKOS_LAMBDA(int i, std::int64_t &update) { update += x(i) != y(i); }, mismatches);
+    double checksum = 0;
+    Kokkos::parallel_reduce("checksum", n, KOKKOS_LAMBDA(int i, double &update) { update += x(i); }, checksum);
+    std::cout << "Same seed, two fills: " << mismatches << " mismatches, checksum " << checksum
+              << " (compare it across --kokkos-num-threads values)\n\n";
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const double bytes = double(n) * sizeof(double);
+
+    runner.run(
+        "rand() uniform 8M double", [&]()
+        {
+        Kokkos::parallel_for("filling vector_reduce", n, KOKKOS_LAMBDA(int i) { x(i) = rand() / double(RAND_MAX); });
+        Kokkos::fence(); },
+        bytes);
+
+    random_fill::Filler<> pooled(2024, random_fill::Stream::pooled);
+    runner.run(
+        "pooled uniform 8M double", [&]()
+        { pooled.uniform(x, 0.0, 1.0); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "reproducible uniform 8M double", [&]()
+        { filler.uniform(x, 0.0, 1.0); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "reproducible normal 8M double", [&]()
+        { filler.normal(x, 0.0, 1.0); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "reproducible integer [0,10) 8M int", [&]()
+        { filler.integer(k, 0, 10); Kokkos::fence(); },
+        double(n) * sizeof(int));
+    runner.run(
+        "reproducible uniform 2048x2048 double", [&]()
+        { filler.uniform(m, 0.0, 100.0); Kokkos::fence(); },
+        double(m.size()) * sizeof(double));
+
+    return runner.finish();
+}
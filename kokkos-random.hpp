@@ -0,0 +1,126 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+#include <cstdint>
+#include <type_traits>
+
+// Parallel random fill of 1D / 2D Views
+// rand() takes a global lock (or races) inside a parallel_for, so fills using it run serially
+// and change from run to run. Here every block of block_size elements owns a generator:
+// - Stream::pooled: the generator is borrowed from a Kokkos::Random_XorShift64_Pool
+//   (reproducible for a fixed seed and a fixed thread count)
+// - Stream::reproducible: the generator of block b is seeded from (seed, b), so the values
+//   only depend on the seed and the element index, whatever the backend or thread count
+//
+//   random_fill::Filler<> fill(2024);
+//   fill.uniform(x, 0.0, 1.0);
+//   fill.normal(A, 0.0, 1.0);
+//   fill.integer(flags, 0, 10); // [0, 10)
+namespace random_fill
+{
+    enum class Stream
+    {
+        pooled,
+        reproducible
+    };
+
+    // splitmix64 finalizer, turns (seed, block) into well separated generator seeds
+    KOKKOS_INLINE_FUNCTION std::uint64_t mix(std::uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace>
+    class Filler
+    {
+    public:
+        using pool_type = Kokkos::Random_XorShift64_Pool<ExecSpace>;
+        using generator_type = Kokkos::Random_XorShift64<ExecSpace>;
+        static constexpr std::int64_t block_size = 1024;
+
+    private:
+        std::uint64_t seed_;
+        Stream stream_;
+        pool_type pool_;
+
+        // Calls draw(gen, flat_index) for every element, rank 1 or 2, one generator per block
+        template <class ViewType, class Draw>
+        void fill(const char *label, const ViewType &v, const Draw &draw) const
+        {
+            static_assert(ViewType::rank == 1 || ViewType::rank == 2, "random_fill supports rank 1 and 2 Views");
+            const std::int64_t n0 = static_cast<std::int64_t>(v.extent(0));
+            const std::int64_t n1 = ViewType::rank == 2 ? static_cast<std::int64_t>(v.extent(1)) : 1;
+            const std::int64_t total = n0 * n1;
+            const std::int64_t blocks = (total + block_size - 1) / block_size;
+            const std::uint64_t seed = seed_;
+            const bool pooled = stream_ == Stream::pooled;
+            const pool_type pool = pool_;
+
+            Kokkos::parallel_for(label, Kokkos::RangePolicy<ExecSpace>(0, blocks), KOKKOS_LAMBDA(std::int64_t b) {
+                const std::int64_t begin = b * block_size;
+                const std::int64_t end = begin + block_size < total ? begin + block_size : total;
+                if (pooled)
+                {
+                    auto gen = pool.get_state();
+                    for (std::int64_t id = begin; id < end; ++id)
+                        store(v, id, n1, draw(gen, id));
+                    pool.free_state(gen);
+                }
+                else
+                {
+                    generator_type gen(mix(seed ^ mix(static_cast<std::uint64_t>(b))));
+                    for (std::int64_t id = begin; id < end; ++id)
+                        store(v, id, n1, draw(gen, id));
+                } });
+        }
+
+        // Flat index in the View's own layout order, so consecutive ids touch consecutive memory
+        template <class ViewType, class T>
+        KOKKOS_INLINE_FUNCTION static void store(const ViewType &v, std::int64_t id, std::int64_t n1, T value)
+        {
+            if constexpr (ViewType::rank == 1)
+                v(id) = value;
+            else if constexpr (std::is_same_v<typename ViewType::array_layout, Kokkos::LayoutLeft>)
+            {
+                const std::int64_t n0 = static_cast<std::int64_t>(v.extent(0));
+                v(id % n0, id / n0) = value;
+            }
+            else
+                v(id / n1, id % n1) = value;
+        }
+
+    public:
+        explicit Filler(std::uint64_t seed, Stream stream = Stream::reproducible)
+            : seed_(seed), stream_(stream), pool_(seed) {}
+
+        std::uint64_t seed() const { return this->seed_; }
+
+        // Uniform in [lo, hi)
+        template <class ViewType>
+        void uniform(const ViewType &v, double lo, double hi) const
+        {
+            using T = typename ViewType::non_const_value_type;
+            fill("random_fill::uniform", v, KOKKOS_LAMBDA(auto &gen, std::int64_t) { return static_cast<T>(gen.drand(lo, hi)); });
+        }
+
+        template <class ViewType>
+        void normal(const ViewType &v, double mean, double stddev) const
+        {
+            using T = typename ViewType::non_const_value_type;
+            fill("random_fill::normal", v, KOKKOS_LAMBDA(auto &gen, std::int64_t) { return static_cast<T>(gen.normal(mean, stddev)); });
+        }
+
+        // Integers in [lo, hi)
+        template <class ViewType>
+        void integer(const ViewType &v, std::int64_t lo, std::int64_t hi) const
+        {
+            using T = typename ViewType::non_const_value_type;
+            static_assert(std::is_integral_v<T>, "random_fill::integer needs an integral View");
+            fill("random_fill::integer", v, KOKKOS_LAMBDA(auto &gen, std::int64_t) { return static_cast<T>(gen.rand64(lo, hi)); });
+        }
+    };
+}
@@ -0,0 +1,162 @@
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+#include "benchmark.hpp"
+#include "kokkos-reducers.hpp"
+
+// Checks the custom reducers against serial host loops, then benchmarks one fused pass
+// against one Kokkos reduction per statistic
+// Usage: ./kokkos-reducers [--kokkos-num-threads=N] [--json file]
+
+constexpr int bins = 16;
+
+bool check(const char *what, double got, double expected, double rel_tol)
+{
+    double err = std::abs(got - expected) / std::max(1.0, std::abs(expected));
+    bool ok = err <= rel_tol;
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << ": " << got << " (reference " << expected << ")\n";
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    const int n = 1 << 22;
+    const double threshold = 0.5;
+    // Values with a large offset and small spread, the hard case for a naive variance
+    const double offset = 1e6;
+    Kokkos::View<double *> x("x", n);
+    Kokkos::parallel_for("fill_x", n, KOKKOS_LAMBDA(int i) {
+        // Cheap deterministic hash in [0, 1)
+        std::uint64_t h = static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+        x(i) = offset + static_cast<double>(h >> 11) * 0x1.0p-53; });
+
+    auto x_host = Kokkos::create_mirror_view(x);
+    Kokkos::deep_copy(x_host, x);
+
+    // Serial reference, summed in long double so its own rounding stays below the tolerances
+    long double ref_total = 0;
+    double ref_min = std::numeric_limits<double>::infinity(), ref_max = -ref_min;
+    std::int64_t ref_above = 0, ref_min_loc = 0, ref_max_loc = 0;
+    std::int64_t ref_hist[bins] = {};
+    for (int i = 0; i < n; ++i)
+    {
+        double v = x_host(i);
+        ref_total += v;
+        if (v < ref_min)
+            ref_min = v, ref_min_loc = i;
+        if (v > ref_max)
+            ref_max = v, ref_max_loc = i;
+        ref_above += v > offset + threshold;
+        int b = static_cast<int>((v - offset) * bins);
+        ref_hist[b < 0 ? 0 : (b >= bins ? bins - 1 : b)] += 1;
+    }
+    const double ref_sum = static_cast<double>(ref_total);
+    double ref_mean = static_cast<double>(ref_total / n), ref_m2 = 0;
+    for (int i = 0; i < n; ++i)
+        ref_m2 += (x_host(i) - ref_mean) * (x_host(i) - ref_mean);
+    double ref_var = ref_m2 / (n - 1);
+
+    std::cout << "\n=== Verification against serial reference (n = " << n << ") ===\n";
+    bool ok = true;
+
+    reducers::StatsValue stats;
+    Kokkos::parallel_reduce("stats", n, KOKKOS_LAMBDA(int i, reducers::StatsValue &update) { update.add(x(i), offset + threshold); }, reducers::Stats<>(stats));
+    ok &= check("Stats sum", stats.sum, ref_sum, 1e-10);
+    ok &= check("Stats min", stats.min, ref_min, 0);
+    ok &= check("Stats max", stats.max, ref_max, 0);
+    ok &= check("Stats count above", double(stats.count_above), double(ref_above), 0);
+
+    reducers::WelfordValue welford;
+    Kokkos::parallel_reduce("welford", n, KOKKOS_LAMBDA(int i, reducers::WelfordValue &update) { update.add(x(i)); }, reducers::Welford<>(welford));
+    // Welford's own rounding grows with the number of chunks joined, ~1e-14 relative on 2 threads
+    ok &= check("Welford mean", welford.mean, ref_mean, 1e-12);
+    ok &= check("Welford variance", welford.variance(), ref_var, 1e-9);
+
+    // Textbook one-pass variance for comparison, sum(x^2)/n - mean^2 cancels with the 1e6 offset
+    double sum_sq = 0;
+    Kokkos::parallel_reduce("sum_sq", n, KOKKOS_LAMBDA(int i, double &update) { update += x(i) * x(i); }, sum_sq);
+    std::cout << "       naive one-pass variance: " << (sum_sq - n * ref_mean * ref_mean) / (n - 1) << "\n";
+
+    reducers::HistogramValue<bins> hist;
+    Kokkos::parallel_reduce("histogram", n, KOKKOS_LAMBDA(int i, reducers::HistogramValue<bins> &update) { update.add(x(i), offset, offset + 1.0); }, reducers::Histogram<bins>(hist));
+    bool hist_ok = hist.nans == 0;
+    for (int b = 0; b < bins; ++b)
+        hist_ok &= hist.counts[b] == ref_hist[b];
+    std::cout << (hist_ok ? "[PASS] " : "[FAIL] ") << "Histogram (" << bins << " bins)\n";
+    ok &= hist_ok;
+
+    // NaN is counted apart, +-inf and far out-of-range values land in the edge bins
+    Kokkos::View<double *> special("special", 5);
+    auto special_host = Kokkos::create_mirror_view(special);
+    const double inf = std::numeric_limits<double>::infinity();
+    special_host(0) = std::numeric_limits<double>::quiet_NaN();
+    special_host(1) = -inf;
+    special_host(2) = inf;
+    special_host(3) = -1e300;
+    special_host(4) = 1e300;
+    Kokkos::deep_copy(special, special_host);
+    reducers::HistogramValue<bins> edges;
+    Kokkos::parallel_reduce("histogram_edges", 5, KOKKOS_LAMBDA(int i, reducers::HistogramValue<bins> &update) { update.add(special(i), 0.0, 1.0); }, reducers::Histogram<bins>(edges));
+    const bool edges_ok = edges.nans == 1 && edges.counts[0] == 2 && edges.counts[bins - 1] == 2;
+    std::cout << (edges_ok ? "[PASS] " : "[FAIL] ") << "Histogram NaN and +-inf\n";
+    ok &= edges_ok;
+
+    reducers::MinMaxLocSumValue mmls;
+    Kokkos::parallel_reduce("minmaxloc_sum", n, KOKKOS_LAMBDA(int i, reducers::MinMaxLocSumValue &update) { update.add(x(i), i); }, reducers::MinMaxLocSum<>(mmls));
+    ok &= check("MinMaxLocSum min_loc", double(mmls.min_loc), double(ref_min_loc), 0);
+    ok &= check("MinMaxLocSum max_loc", double(mmls.max_loc), double(ref_max_loc), 0);
+    ok &= check("MinMaxLocSum sum", mmls.sum, ref_sum, 1e-10);
+
+    // Benchmark: fused single pass against one reduction per statistic
+    std::cout << "\n=== Fused against separate reductions ===\n";
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const double bytes = double(n) * sizeof(double);
+    runner.run(
+        "separate Sum/Min/Max/count (4 passes)", [&]()
+        {
+        double sum = 0, lo = 0, hi = 0;
+        std::int64_t above = 0;
+        Kokkos::parallel_reduce("sum", n, KOKKOS_LAMBDA(int i, double &u) { u += x(i); }, sum);
+        Kokkos::parallel_reduce("min", n, KOKKOS_LAMBDA(int i, double &u) { u = x(i) < u ? x(i) : u; }, Kokkos::Min<double>(lo));
+        Kokkos::parallel_reduce("max", n, KOKKOS_LAMBDA(int i, double &u) { u = x(i) > u ? x(i) : u; }, Kokkos::Max<double>(hi));
+        Kokkos::parallel_reduce("count", n, KOKKOS_LAMBDA(int i, std::int64_t &u) { u += x(i) > offset + threshold; }, above);
+        bench::DoNotOptimize(sum); },
+        4 * bytes);
+    runner.run(
+        "fused reducers::Stats (1 pass)", [&]()
+        {
+        reducers::StatsValue s;
+        Kokkos::parallel_reduce("stats", n, KOKKOS_LAMBDA(int i, reducers::StatsValue &u) { u.add(x(i), offset + threshold); }, reducers::Stats<>(s));
+        bench::DoNotOptimize(s); },
+        bytes);
+    runner.run(
+        "separate MinMaxLoc + Sum (2 passes)", [&]()
+        {
+        Kokkos::MinMaxLoc<double, int>::value_type mm;
+        double sum = 0;
+        Kokkos::parallel_reduce("minmaxloc", n, KOKKOS_LAMBDA(int i, Kokkos::MinMaxLoc<double, int>::value_type &u) {
+            if (x(i) < u.min_val) { u.min_val = x(i); u.min_loc = i; }
+            if (x(i) > u.max_val) { u.max_val = x(i); u.max_loc = i; } }, Kokkos::MinMaxLoc<double, int>(mm));
+        Kokkos::parallel_reduce("sum", n, KOKKOS_LAMBDA(int i, double &u) { u += x(i); }, sum);
+        bench::DoNotOptimize(sum); },
+        2 * bytes);
+    runner.run(
+        "fused reducers::MinMaxLocSum (1 pass)", [&]()
+        {
+        reducers::MinMaxLocSumValue v;
+        Kokkos::parallel_reduce("minmaxloc_sum", n, KOKKOS_LAMBDA(int i, reducers::MinMaxLocSumValue &u) { u.add(x(i), i); }, reducers::MinMaxLocSum<>(v));
+        bench::DoNotOptimize(v); },
+        bytes);
+
+    int status = runner.finish();
+    std::cout << "\nVerification " << (ok ? "passed" : "FAILED") << "\n";
+    return ok ? status : 1;
+}
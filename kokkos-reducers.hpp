@@ -0,0 +1,252 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+
+// Custom Kokkos reducers
+// A reducer tells Kokkos how to initialize (init) and combine (join) per-thread partial results,
+// so every partial starts from the identity (min = +inf, max = -inf, ...) on every backend.
+// Passing a plain struct to parallel_reduce instead only works for sums.
+//
+// Each reduction is described by an Op with value_type, init and join, and wrapped by Reducer:
+//   reducers::StatsValue s;
+//   Kokkos::parallel_reduce("stats", n, KOKKOS_LAMBDA(int i, reducers::StatsValue &u) { u.add(x(i), 0.5); },
+//                           reducers::Stats<>(s));
+namespace reducers
+{
+    template <class Op, class Space = Kokkos::HostSpace>
+    class Reducer
+    {
+    public:
+        using reducer = Reducer;
+        using value_type = typename Op::value_type;
+        using result_view_type = Kokkos::View<value_type, Space, Kokkos::MemoryUnmanaged>;
+
+    private:
+        result_view_type value_;
+        bool references_scalar_v_;
+
+    public:
+        KOKKOS_INLINE_FUNCTION
+        Reducer(value_type &value) : value_(&value), references_scalar_v_(true) {}
+
+        KOKKOS_INLINE_FUNCTION
+        Reducer(const result_view_type &value) : value_(value), references_scalar_v_(false) {}
+
+        KOKKOS_INLINE_FUNCTION
+        void join(value_type &dest, const value_type &src) const { Op::join(dest, src); }
+
+        KOKKOS_INLINE_FUNCTION
+        void init(value_type &val) const { Op::init(val); }
+
+        KOKKOS_INLINE_FUNCTION
+        value_type &reference() const { return *value_.data(); }
+
+        KOKKOS_INLINE_FUNCTION
+        result_view_type view() const { return value_; }
+
+        KOKKOS_INLINE_FUNCTION
+        bool references_scalar() const { return references_scalar_v_; }
+    };
+
+    // sum, min, max and count of values above a threshold in one pass
+    struct StatsValue
+    {
+        double sum;
+        double min;
+        double max;
+        std::int64_t count_above;
+        std::int64_t count;
+
+        KOKKOS_INLINE_FUNCTION
+        void add(double x, double threshold)
+        {
+            sum += x;
+            min = x < min ? x : min;
+            max = x > max ? x : max;
+            count_above += x > threshold;
+            count += 1;
+        }
+    };
+
+    struct StatsOp
+    {
+        using value_type = StatsValue;
+
+        KOKKOS_INLINE_FUNCTION static void init(value_type &v)
+        {
+            v.sum = 0.0;
+            v.min = Kokkos::reduction_identity<double>::min();
+            v.max = Kokkos::reduction_identity<double>::max();
+            v.count_above = 0;
+            v.count = 0;
+        }
+
+        KOKKOS_INLINE_FUNCTION static void join(value_type &dest, const value_type &src)
+        {
+            dest.sum += src.sum;
+            dest.min = src.min < dest.min ? src.min : dest.min;
+            dest.max = src.max > dest.max ? src.max : dest.max;
+            dest.count_above += src.count_above;
+            dest.count += src.count;
+        }
+    };
+
+    // Welford's running mean / variance, partials merged with Chan et al.'s pairwise update
+    // Stable where sum(x^2) - n mean^2 cancels catastrophically (large mean, small spread)
+    struct WelfordValue
+    {
+        double count;
+        double mean;
+        double m2; // sum of squared deviations from the mean
+
+        KOKKOS_INLINE_FUNCTION
+        void add(double x)
+        {
+            count += 1.0;
+            double delta = x - mean;
+            mean += delta / count;
+            m2 += delta * (x - mean);
+        }
+
+        KOKKOS_INLINE_FUNCTION double variance() const { return count > 1.0 ? m2 / (count - 1.0) : 0.0; }
+        KOKKOS_INLINE_FUNCTION double population_variance() const { return count > 0.0 ? m2 / count : 0.0; }
+    };
+
+    struct WelfordOp
+    {
+        using value_type = WelfordValue;
+
+        KOKKOS_INLINE_FUNCTION static void init(value_type &v)
+        {
+            v.count = 0.0;
+            v.mean = 0.0;
+            v.m2 = 0.0;
+        }
+
+        KOKKOS_INLINE_FUNCTION static void join(value_type &dest, const value_type &src)
+        {
+            if (src.count == 0.0)
+                return;
+            if (dest.count == 0.0)
+            {
+                dest = src;
+                return;
+            }
+            double count = dest.count + src.count;
+            double delta = src.mean - dest.mean;
+            dest.mean += delta * src.count / count;
+            dest.m2 += src.m2 + delta * delta * dest.count * src.count / count;
+            dest.count = count;
+        }
+    };
+
+    // Fixed-bin histogram over [lo, hi), values outside (-inf and +inf included) are clamped
+    // into the edge bins; NaNs fall in no bin and are counted in nans
+    template <int Bins>
+    struct HistogramValue
+    {
+        std::int64_t counts[Bins];
+        std::int64_t nans;
+
+        KOKKOS_INLINE_FUNCTION
+        void add(double x, double lo, double hi)
+        {
+            // Clamped as a double: the int conversion of an out-of-range value is undefined
+            const double t = (x - lo) / (hi - lo) * Bins;
+            if (t != t)
+            {
+                nans += 1;
+                return;
+            }
+            counts[t < 0.0 ? 0 : (t >= Bins - 1 ? Bins - 1 : static_cast<int>(t))] += 1;
+        }
+    };
+
+    template <int Bins>
+    struct HistogramOp
+    {
+        using value_type = HistogramValue<Bins>;
+
+        KOKKOS_INLINE_FUNCTION static void init(value_type &v)
+        {
+            for (int b = 0; b < Bins; ++b)
+                v.counts[b] = 0;
+            v.nans = 0;
+        }
+
+        KOKKOS_INLINE_FUNCTION static void join(value_type &dest, const value_type &src)
+        {
+            for (int b = 0; b < Bins; ++b)
+                dest.counts[b] += src.counts[b];
+            dest.nans += src.nans;
+        }
+    };
+
+    // Kokkos::MinMaxLoc plus the sum, ties keep the lowest index
+    struct MinMaxLocSumValue
+    {
+        double min_val;
+        double max_val;
+        std::int64_t min_loc;
+        std::int64_t max_loc;
+        double sum;
+
+        KOKKOS_INLINE_FUNCTION
+        void add(double x, std::int64_t i)
+        {
+            if (x < min_val || (x == min_val && i < min_loc))
+            {
+                min_val = x;
+                min_loc = i;
+            }
+            if (x > max_val || (x == max_val && i < max_loc))
+            {
+                max_val = x;
+                max_loc = i;
+            }
+            sum += x;
+        }
+    };
+
+    struct MinMaxLocSumOp
+    {
+        using value_type = MinMaxLocSumValue;
+
+        KOKKOS_INLINE_FUNCTION static void init(value_type &v)
+        {
+            v.min_val = Kokkos::reduction_identity<double>::min();
+            v.max_val = Kokkos::reduction_identity<double>::max();
+            v.min_loc = Kokkos::reduction_identity<std::int64_t>::min();
+            v.max_loc = Kokkos::reduction_identity<std::int64_t>::min();
+            v.sum = 0.0;
+        }
+
+        KOKKOS_INLINE_FUNCTION static void join(value_type &dest, const value_type &src)
+        {
+            if (src.min_val < dest.min_val || (src.min_val == dest.min_val && src.min_loc < dest.min_loc))
+            {
+                dest.min_val = src.min_val;
+                dest.min_loc = src.min_loc;
+            }
+            if (src.max_val > dest.max_val || (src.max_val == dest.max_val && src.max_loc < dest.max_loc))
+            {
+                dest.max_val = src.max_val;
+                dest.max_loc = src.max_loc;
+            }
+            dest.sum += src.sum;
+        }
+    };
+
+    template <class Space = Kokkos::HostSpace>
+    using Stats = Reducer<StatsOp, Space>;
+
+    template <class Space = Kokkos::HostSpace>
+    using Welford = Reducer<WelfordOp, Space>;
+
+    template <int Bins, class Space = Kokkos::HostSpace>
+    using Histogram = Reducer<HistogramOp<Bins>, Space>;
+
+    template <class Space = Kokkos::HostSpace>
+    using MinMaxLocSum = Reducer<MinMaxLocSumOp, Space>;
+}
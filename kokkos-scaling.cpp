@@ -0,0 +1,403 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Strong and weak scaling report for the Kokkos benchmark programs
+// Runs every program of the table below from one or more build directories (one per Kokkos
+// backend, see CMakeLists.txt) with --kokkos-num-threads=T and --json, and reads the medians back:
+// - strong scaling, at every size of the table: speedup S(T) = t(1) / t(T), efficiency S(T) / T
+// - weak scaling, from the smallest size: the problem grows with T so the work per thread stays
+//   constant (size * T^(1/d) for work ~ size^d), efficiency t(1) / t(T), scaled speedup T * that
+// Benchmarks are matched by name across thread counts, and by position across sizes (their names
+// carry the size). A benchmark whose name stays the same at every size does not follow the size
+// flag (the fixed-shape cases of kokkos-transpose) and is left out of the weak scaling report. The thread count is the concurrency the program reports, so a backend that
+// ignores --kokkos-num-threads (Serial) gives a single column instead of a fake scaling curve.
+// Usage: ./kokkos-scaling [--bin-dir [label=]dir]... [--threads 1,2,4,8] [--programs a,b]
+//                         [--filter name] [--samples n] [--min-time s] [--work-dir d] [--csv file]
+//   --bin-dir defaults to the current directory, --threads to 1, 2, 4, ... up to the hardware threads
+namespace scaling
+{
+    // How one program is run at a given size
+    struct Program
+    {
+        std::string name;
+        std::string size_flag;            // empty: fixed problem sizes, strong scaling only
+        std::vector<long long> sizes;     // strong scaling sizes, the first is the weak scaling base
+        int dimensions = 1;               // work ~ size^dimensions
+        std::vector<std::string> extra{}; // arguments added to every run
+    };
+
+    // kokkos-views-pro sweeps thread counts itself (partition_space) and kokkos-autotune has no
+    // bench::Runner output, so neither is listed
+    inline std::vector<Program> programs()
+    {
+        return {
+            {"kokkos-simd-reductions", "--size", {1 << 22, 1 << 24}, 1},
+            {"kokkos-compact", "--size", {1 << 20, 1 << 24}, 1},
+            {"kokkos-gemm", "--size", {512, 1024}, 3},
+            {"kokkos-stencil", "--grid", {1024, 2048}, 2},
+            {"kokkos-transpose", "--size", {2048, 4096}, 2},
+            {"kokkos-sparse", "--grid", {512, 1024}, 2},
+            {"kokkos-task-graph", "--copies", {4, 8}, 1},
+            {"kokkos-view-io", "--mb", {64, 256}, 1},
+            {"kokkos-reducers", "", {}, 1},
+            {"kokkos-benchmarks", "", {}, 1},
+            {"kokkos-expressions", "", {}, 1},
+            {"kokkos-selection", "", {}, 1},
+            {"kokkos-random-fill", "", {}, 1},
+            {"kokkos-workspace", "", {}, 1},
+        };
+    }
+
+    struct Median
+    {
+        std::string name;
+        double median_ns;
+    };
+
+    // One program run
+    struct Run
+    {
+        bool ok = false;
+        int concurrency = 0;
+        std::vector<Median> results; // in the order the program ran them
+    };
+
+    // name/median_ns pairs of a bench::Runner JSON file, in file order
+    inline std::vector<Median> read_json(const std::string &path)
+    {
+        std::vector<Median> results;
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            auto name_pos = line.find("\"name\": \"");
+            auto median_pos = line.find("\"median_ns\": ");
+            if (name_pos == std::string::npos || median_pos == std::string::npos)
+                continue;
+            name_pos += 9;
+            results.push_back({line.substr(name_pos, line.find('"', name_pos) - name_pos), std::atof(line.c_str() + median_pos + 13)});
+        }
+        return results;
+    }
+
+    // The "concurrency N" every Kokkos program prints first, 0 if missing (thread count unknown)
+    inline int read_concurrency(const std::string &log)
+    {
+        std::ifstream in(log);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            auto pos = line.find("concurrency ");
+            if (pos != std::string::npos)
+                return std::atoi(line.c_str() + pos + 12);
+        }
+        return 0;
+    }
+
+    inline std::string quote(const std::string &s) { return "'" + s + "'"; }
+
+    struct Options
+    {
+        std::vector<std::pair<std::string, std::string>> bin_dirs; // label, directory
+        std::vector<int> threads;
+        std::vector<std::string> programs;
+        std::string filter;
+        int samples = 5;
+        double min_time = 0.05;
+        std::string work_dir = "scaling-runs";
+        std::string csv_file;
+    };
+
+    inline std::vector<std::string> split(const std::string &list)
+    {
+        std::vector<std::string> items;
+        std::stringstream ss(list);
+        std::string item;
+        while (std::getline(ss, item, ','))
+            if (!item.empty())
+                items.push_back(item);
+        return items;
+    }
+
+    struct Row
+    {
+        std::string backend, program, kind, benchmark;
+        long long size;
+        int threads;
+        double median_ns, speedup, efficiency;
+    };
+
+    class Driver
+    {
+        Options options_;
+        std::vector<Row> rows_;
+        int failures_ = 0;
+
+    public:
+        explicit Driver(Options options) : options_(std::move(options)) {}
+
+        int failures() const { return this->failures_; }
+
+        // Runs dir/program with the given size and thread count; results go to work_dir
+        Run run(const std::string &backend, const std::string &dir, const Program &p, long long size, int threads)
+        {
+            const std::string stem = options_.work_dir + "/" + backend + "-" + p.name +
+                                     (p.size_flag.empty() ? "" : "-" + std::to_string(size)) + "-t" + std::to_string(threads);
+            std::string command = quote(dir + "/" + p.name);
+            if (!p.size_flag.empty())
+                command += " " + p.size_flag + " " + std::to_string(size);
+            for (const std::string &arg : p.extra)
+                command += " " + quote(arg);
+            command += " --kokkos-num-threads=" + std::to_string(threads) + " --json " + quote(stem + ".json") +
+                       " --samples " + std::to_string(options_.samples) + " --min-time " + std::to_string(options_.min_time);
+            if (!options_.filter.empty())
+                command += " --filter " + quote(options_.filter);
+            command += " > " + quote(stem + ".log") + " 2>&1";
+
+            std::cout << "  " << p.name << (p.size_flag.empty() ? "" : " " + p.size_flag + " " + std::to_string(size))
+                      << " on " << threads << " threads" << std::flush;
+            std::filesystem::remove(stem + ".json");
+            Run r;
+            r.ok = std::system(command.c_str()) == 0;
+            r.concurrency = read_concurrency(stem + ".log");
+            r.results = read_json(stem + ".json");
+            std::cout << (r.ok ? "" : "  FAILED, see " + stem + ".log") << "\n";
+            failures_ += !r.ok;
+            return r;
+        }
+
+        void run_backend(const std::string &backend, const std::string &dir)
+        {
+            for (const Program &p : programs())
+            {
+                if (!options_.programs.empty() && std::find(options_.programs.begin(), options_.programs.end(), p.name) == options_.programs.end())
+                    continue;
+                if (!std::filesystem::exists(dir + "/" + p.name))
+                {
+                    std::cout << "[" << backend << "] " << p.name << " not built in " << dir << ", skipped\n";
+                    continue;
+                }
+                std::cout << "[" << backend << "] " << p.name << "\n";
+                const std::vector<long long> sizes = p.sizes.empty() ? std::vector<long long>{0} : p.sizes;
+
+                // Strong scaling; the runs at the base size are also the T = 1 weak scaling point
+                std::vector<std::vector<std::pair<int, Run>>> strong(sizes.size());
+                for (std::size_t s = 0; s < sizes.size(); ++s)
+                    strong[s] = sweep(backend, dir, p, [&](int) { return sizes[s]; });
+                for (std::size_t s = 0; s < sizes.size(); ++s)
+                    report_strong(backend, p, sizes[s], strong[s]);
+
+                if (p.size_flag.empty() || strong[0].size() < 2)
+                    continue;
+                auto weak = sweep(backend, dir, p, [&](int threads) { return weak_size(p, threads); }, &strong[0]);
+                report_weak(backend, p, weak);
+            }
+        }
+
+        // Problem size with the same work per thread on `threads` threads as the base size on one
+        static long long weak_size(const Program &p, int threads)
+        {
+            return std::llround(p.sizes[0] * std::pow(double(threads), 1.0 / p.dimensions));
+        }
+
+        void write_csv(const std::string &path) const
+        {
+            std::ofstream out(path);
+            out.precision(12);
+            out << "backend,program,scaling,size,threads,benchmark,median_ns,speedup,efficiency\n";
+            for (const Row &r : rows_)
+                out << r.backend << "," << r.program << "," << r.kind << "," << r.size << "," << r.threads << ",\""
+                    << r.benchmark << "\"," << r.median_ns << "," << r.speedup << "," << r.efficiency << "\n";
+        }
+
+    private:
+        // One run per requested thread count, keyed by the concurrency the program reported;
+        // stops early when the backend does not honor the thread count. `reuse` holds runs that
+        // can stand in for the ones of the same thread count (the base size runs for weak scaling)
+        template <class SizeOf>
+        std::vector<std::pair<int, Run>> sweep(const std::string &backend, const std::string &dir, const Program &p, SizeOf size_of,
+                                               const std::vector<std::pair<int, Run>> *reuse = nullptr)
+        {
+            std::vector<std::pair<int, Run>> runs;
+            for (int threads : options_.threads)
+            {
+                const Run *same = nullptr;
+                if (reuse)
+                    for (const auto &[t, r] : *reuse)
+                        if (t == threads && size_of(threads) == size_of(1))
+                            same = &r;
+                Run r = same ? *same : run(backend, dir, p, size_of(threads), threads);
+                if (!r.ok || r.results.empty())
+                    continue;
+                // Without a reported concurrency the thread count is unknown: taking T for it
+                // would turn a backend that ignores T into a fake scaling curve
+                if (r.concurrency <= 0)
+                {
+                    std::cout << "  " << p.name << " [" << backend << "] prints no \"concurrency N\", skipped\n";
+                    break;
+                }
+                const int actual = r.concurrency;
+                if (actual != threads)
+                    std::cout << "  " << backend << " runs on " << actual << " threads when asked for " << threads << "\n";
+                if (!runs.empty() && runs.back().first >= actual)
+                    break;
+                runs.emplace_back(actual, std::move(r));
+            }
+            return runs;
+        }
+
+        static const Median *find(const Run &r, const std::string &name)
+        {
+            for (const Median &m : r.results)
+                if (m.name == name)
+                    return &m;
+            return nullptr;
+        }
+
+        static void print_header(const std::vector<std::pair<int, Run>> &runs, const char *first)
+        {
+            std::printf("%-48s %12s", "benchmark", first);
+            for (const auto &[threads, r] : runs)
+                std::printf("   T=%-11d", threads);
+            std::printf("\n");
+        }
+
+        void report_strong(const std::string &backend, const Program &p, long long size, const std::vector<std::pair<int, Run>> &runs)
+        {
+            if (runs.empty())
+                return;
+            std::cout << "\n=== " << p.name << " [" << backend << "] strong scaling"
+                      << (p.size_flag.empty() ? "" : ", " + p.size_flag + " " + std::to_string(size)) << " ===\n";
+            std::cout << "speedup over T=" << runs.front().first << " and parallel efficiency\n";
+            print_header(runs, "median ms");
+            for (const Median &base : runs.front().second.results)
+            {
+                std::printf("%-48s %12.3f", base.name.c_str(), base.median_ns * 1e-6);
+                for (const auto &[threads, r] : runs)
+                {
+                    const Median *m = find(r, base.name);
+                    if (!m || m->median_ns <= 0)
+                    {
+                        std::printf("   %-13s", "-");
+                        continue;
+                    }
+                    const double speedup = base.median_ns / m->median_ns;
+                    const double efficiency = speedup * runs.front().first / threads;
+                    std::printf("   %5.2fx %4.0f%% ", speedup, efficiency * 100);
+                    rows_.push_back({backend, p.name, "strong", base.name, size, threads, m->median_ns, speedup, efficiency});
+                }
+                std::printf("\n");
+            }
+        }
+
+        void report_weak(const std::string &backend, const Program &p, const std::vector<std::pair<int, Run>> &runs)
+        {
+            if (runs.size() < 2)
+                return;
+            std::cout << "\n=== " << p.name << " [" << backend << "] weak scaling, " << p.size_flag;
+            for (const auto &[threads, r] : runs)
+                std::cout << " " << weak_size(p, threads);
+            std::cout << " ===\n";
+            std::cout << "scaled speedup T * t(1) / t(T) and weak scaling efficiency t(1) / t(T)\n";
+            const std::vector<Median> &base = runs.front().second.results;
+            for (const auto &[threads, r] : runs)
+                if (r.results.size() != base.size())
+                {
+                    std::cout << "benchmark lists differ between sizes, no weak scaling report\n";
+                    return;
+                }
+            print_header(runs, "median ms");
+            int fixed = 0;
+            for (std::size_t b = 0; b < base.size(); ++b)
+            {
+                bool follows_size = true;
+                for (std::size_t k = 1; k < runs.size(); ++k)
+                    follows_size &= runs[k].second.results[b].name != base[b].name;
+                if (!follows_size)
+                {
+                    ++fixed;
+                    continue;
+                }
+                std::printf("%-48s %12.3f", base[b].name.c_str(), base[b].median_ns * 1e-6);
+                for (const auto &[threads, r] : runs)
+                {
+                    const double efficiency = r.results[b].median_ns > 0 ? base[b].median_ns / r.results[b].median_ns : 0.0;
+                    const double speedup = efficiency * threads / runs.front().first;
+                    std::printf("   %5.2fx %4.0f%% ", speedup, efficiency * 100);
+                    rows_.push_back({backend, p.name, "weak", base[b].name, weak_size(p, threads), threads, r.results[b].median_ns, speedup, efficiency});
+                }
+                std::printf("\n");
+            }
+            if (fixed > 0)
+                std::cout << fixed << " benchmarks keep the same size whatever " << p.size_flag << " is, left out\n";
+        }
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    scaling::Options options;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const std::string key = argv[i], value = argv[i + 1];
+        if (key == "--bin-dir")
+        {
+            const auto eq = value.find('=');
+            std::string label = eq == std::string::npos ? value : value.substr(0, eq);
+            std::replace(label.begin(), label.end(), '/', '_'); // the label names the run files
+            options.bin_dirs.emplace_back(label, value.substr(eq == std::string::npos ? 0 : eq + 1));
+        }
+        else if (key == "--threads")
+            for (const std::string &t : scaling::split(value))
+                options.threads.push_back(std::max(1, std::atoi(t.c_str())));
+        else if (key == "--programs")
+            options.programs = scaling::split(value);
+        else if (key == "--filter")
+            options.filter = value;
+        else if (key == "--samples")
+            options.samples = std::atoi(value.c_str());
+        else if (key == "--min-time")
+            options.min_time = std::atof(value.c_str());
+        else if (key == "--work-dir")
+            options.work_dir = value;
+        else if (key == "--csv")
+            options.csv_file = value;
+        else
+            continue;
+        ++i;
+    }
+    if (options.bin_dirs.empty())
+        options.bin_dirs.emplace_back("default", ".");
+    if (options.threads.empty())
+    {
+        const int hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (int t = 1; t < hardware; t *= 2)
+            options.threads.push_back(t);
+        options.threads.push_back(hardware);
+    }
+    std::sort(options.threads.begin(), options.threads.end());
+    options.threads.erase(std::unique(options.threads.begin(), options.threads.end()), options.threads.end());
+    std::filesystem::create_directories(options.work_dir);
+
+    const std::string csv_file = options.csv_file;
+    const auto bin_dirs = options.bin_dirs;
+    scaling::Driver driver(std::move(options));
+    for (const auto &[backend, dir] : bin_dirs)
+        driver.run_backend(backend, dir);
+    if (!csv_file.empty())
+        driver.write_csv(csv_file);
+    if (driver.failures() > 0)
+        std::cout << "\n"
+                  << driver.failures() << " runs failed\n";
+    return driver.failures() > 0 ? 1 : 0;
+}
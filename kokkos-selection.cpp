@@ -0,0 +1,226 @@
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "kokkos-random.hpp"
+#include "kokkos-selection.hpp"
+
+// top_k, nth_value / quantile and radix sort checked against the standard library, then
+// benchmarked against std::partial_sort, std::nth_element, std::sort and Kokkos::sort
+// Every benchmark restores its input first (the std versions copy into a std::vector, the
+// Kokkos versions deep_copy into a View), so all of them pay for one copy of the data.
+// Usage: ./kokkos-selection [--kokkos-num-threads=T] [--json file]
+
+bool report(const std::string &what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+template <class T>
+std::vector<T> to_vector(const Kokkos::View<T *> &v)
+{
+    auto host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v);
+    return std::vector<T>(host.data(), host.data() + host.extent(0));
+}
+
+template <class T>
+bool check_top_k(const Kokkos::View<T *> &v, int k)
+{
+    std::vector<T> values = to_vector(v);
+    std::vector<std::int64_t> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](std::int64_t a, std::int64_t b)
+                      { return values[a] > values[b] || (values[a] == values[b] && a < b); });
+    auto top = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), selection::top_k(v, k));
+    bool ok = static_cast<int>(top.extent(0)) == k;
+    for (int j = 0; ok && j < k; ++j)
+        ok = top(j).index == order[j] && top(j).value == values[order[j]];
+    return ok;
+}
+
+template <class T>
+bool check_nth(const Kokkos::View<T *> &v, std::int64_t k)
+{
+    std::vector<T> values = to_vector(v);
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return selection::nth_value(v, k) == values[k];
+}
+
+// Sorted keys, and every value still points at its original key; equal keys keep their order
+template <class T>
+bool check_sort_by_key(const Kokkos::View<T *> &v)
+{
+    const std::int64_t n = static_cast<std::int64_t>(v.extent(0));
+    Kokkos::View<T *> keys("keys", n);
+    Kokkos::View<std::int64_t *> index("index", n);
+    Kokkos::deep_copy(keys, v);
+    Kokkos::parallel_for("iota", n, KOKKOS_LAMBDA(std::int64_t i) { index(i) = i; });
+    selection::sort_by_key(keys, index);
+    std::vector<T> original = to_vector(v), sorted = to_vector(keys);
+    std::vector<std::int64_t> idx = to_vector(index);
+    std::vector<T> expected = original;
+    std::sort(expected.begin(), expected.end());
+    bool ok = sorted == expected;
+    for (std::int64_t i = 0; ok && i < n; ++i)
+        ok = original[idx[i]] == sorted[i] && (i == 0 || sorted[i - 1] != sorted[i] || idx[i - 1] < idx[i]);
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    random_fill::Filler<> random(2024);
+
+    std::cout << "\n=== Verification ===\n";
+    bool ok = true;
+    {
+        const int n = 1000003;
+        Kokkos::View<double *> d("d", n);
+        Kokkos::View<float *> f("f", n);
+        Kokkos::View<int *> small("small", n); // many duplicates
+        random.normal(d, 0.0, 10.0);
+        random.uniform(f, -1.0, 1.0);
+        random.integer(small, -50, 50);
+
+        ok &= report("top_k(100) double matches std::partial_sort", check_top_k(d, 100));
+        ok &= report("top_k(37) int with ties matches std::partial_sort", check_top_k(small, 37));
+        ok &= report("nth_value double (median) matches std::nth_element", check_nth(d, n / 2));
+        ok &= report("nth_value int with duplicates matches std::nth_element", check_nth(small, n / 3));
+        ok &= report("nth_value float (rank 7) matches std::nth_element", check_nth(f, 7));
+
+        std::vector<double> dv = to_vector(d);
+        std::sort(dv.begin(), dv.end());
+        double pos = 0.9 * (n - 1);
+        std::int64_t k = static_cast<std::int64_t>(pos);
+        double expected = dv[k] + (pos - k) * (dv[k + 1] - dv[k]);
+        ok &= report("quantile(0.9) matches interpolated sorted ranks", selection::quantile(d, 0.9) == expected);
+
+        int rejected = 0;
+        const auto rejects = [&](auto call)
+        {
+            try
+            {
+                call();
+            }
+            catch (const std::invalid_argument &)
+            {
+                ++rejected;
+            }
+        };
+        rejects([&]
+                { selection::top_k(d, 0); });
+        rejects([&]
+                { selection::top_k(d, n + 1); });
+        rejects([&]
+                { selection::nth_value(d, n); });
+        rejects([&]
+                { selection::quantile(d, 1.5); });
+        rejects([&]
+                { selection::quantile(Kokkos::View<double *>("empty", 0), 0.5); });
+        ok &= report("k, rank and q out of range throw std::invalid_argument", rejected == 5);
+
+        ok &= report("sort_by_key double (negative keys) sorted and stable", check_sort_by_key(d));
+        ok &= report("sort_by_key float sorted and stable", check_sort_by_key(f));
+        ok &= report("sort_by_key int with duplicates sorted and stable", check_sort_by_key(small));
+    }
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const int n = 1 << 24;
+    const int k = 100;
+    Kokkos::View<double *> input("input", n), work("work", n);
+    Kokkos::View<std::int64_t *> index("index", n);
+    Kokkos::View<int *> int_input("int_input", n), int_work("int_work", n);
+    random.normal(input, 0.0, 10.0);
+    random.integer(int_input, 0, 1 << 30);
+    std::vector<double> host_input = to_vector(input), host_work(n);
+    std::vector<int> host_int_input = to_vector(int_input), host_int_work(n);
+    const double bytes = double(n) * sizeof(double);
+
+    runner.run(
+        "top 100 std::partial_sort 16M double", [&]()
+        {
+        host_work = host_input;
+        std::partial_sort(host_work.begin(), host_work.begin() + k, host_work.end(), std::greater<double>());
+        bench::DoNotOptimize(host_work[0]); },
+        bytes);
+    runner.run(
+        "top 100 selection::top_k 16M double", [&]()
+        { bench::DoNotOptimize(selection::top_k(input, k)); Kokkos::fence(); },
+        bytes);
+
+    runner.run(
+        "median std::nth_element 16M double", [&]()
+        {
+        host_work = host_input;
+        std::nth_element(host_work.begin(), host_work.begin() + n / 2, host_work.end());
+        bench::DoNotOptimize(host_work[n / 2]); },
+        bytes);
+    runner.run(
+        "median selection::nth_value 16M double", [&]()
+        { bench::DoNotOptimize(selection::nth_value(input, n / 2)); },
+        bytes);
+
+    runner.run(
+        "sort std::sort 16M double", [&]()
+        {
+        host_work = host_input;
+        std::sort(host_work.begin(), host_work.end());
+        bench::DoNotOptimize(host_work[0]); },
+        bytes);
+    runner.run(
+        "sort Kokkos::sort 16M double", [&]()
+        { Kokkos::deep_copy(work, input); Kokkos::sort(work); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "sort selection::radix_sort 16M double", [&]()
+        { Kokkos::deep_copy(work, input); selection::radix_sort(work); Kokkos::fence(); },
+        bytes);
+
+    runner.run(
+        "sort std::sort 16M int", [&]()
+        {
+        host_int_work = host_int_input;
+        std::sort(host_int_work.begin(), host_int_work.end());
+        bench::DoNotOptimize(host_int_work[0]); },
+        double(n) * sizeof(int));
+    runner.run(
+        "sort Kokkos::sort 16M int", [&]()
+        { Kokkos::deep_copy(int_work, int_input); Kokkos::sort(int_work); Kokkos::fence(); },
+        double(n) * sizeof(int));
+    runner.run(
+        "sort selection::radix_sort 16M int", [&]()
+        { Kokkos::deep_copy(int_work, int_input); selection::radix_sort(int_work); Kokkos::fence(); },
+        double(n) * sizeof(int));
+
+    // Key/value: std::sort on an index permutation against the radix sort carrying the indices
+    std::vector<std::int64_t> order(n);
+    runner.run(
+        "sort_by_key std::sort permutation 16M double", [&]()
+        {
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::int64_t a, std::int64_t b) { return host_input[a] < host_input[b]; });
+        bench::DoNotOptimize(order[0]); },
+        double(n) * (sizeof(double) + sizeof(std::int64_t)));
+    runner.run(
+        "sort_by_key selection 16M double", [&]()
+        {
+        Kokkos::deep_copy(work, input);
+        Kokkos::parallel_for("iota", n, KOKKOS_LAMBDA(std::int64_t i) { index(i) = i; });
+        selection::sort_by_key(work, index);
+        Kokkos::fence(); },
+        double(n) * (sizeof(double) + sizeof(std::int64_t)));
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "kokkos-compact.hpp"
+
+// Order statistics and sorting on 1D Views (float, double and integer values, host backends)
+// - top_k: the k largest values with their indices, best first; per-chunk heaps built in
+//   parallel, then merged pairwise in a tree of parallel rounds
+// - nth_value / quantile: parallel quickselect, each round partitions the candidates around a
+//   sampled pivot with compact::select and keeps only the side holding the wanted rank
+// - radix_sort / sort_by_key: stable LSD radix sort, 8 bits per pass, parallel over blocks
+//   (per-block histograms, one scan in digit-major order, per-block stable scatter)
+// top_k, nth_value and quantile throw std::invalid_argument for a rank or quantile outside the
+// View. They compare with < and >, under which NaN is unordered: with NaNs in the input the
+// result is unspecified (filter them out with compact::select first). radix_sort orders
+// NaNs by their bits, after +inf (or before -inf for a negative sign bit).
+namespace selection
+{
+    template <class T>
+    struct Item
+    {
+        T value;
+        std::int64_t index;
+    };
+
+    // Larger value first, ties broken by the lower index so results are deterministic
+    template <class T>
+    KOKKOS_INLINE_FUNCTION bool better(const Item<T> &a, const Item<T> &b)
+    {
+        return a.value > b.value || (a.value == b.value && a.index < b.index);
+    }
+
+    // Heap rows keep the worst kept item at the root
+    template <class Heaps>
+    KOKKOS_INLINE_FUNCTION void sift_down(const Heaps &h, std::int64_t c, int j, int size)
+    {
+        while (true)
+        {
+            int worst = j, l = 2 * j + 1, r = l + 1;
+            if (l < size && better(h(c, worst), h(c, l)))
+                worst = l;
+            if (r < size && better(h(c, worst), h(c, r)))
+                worst = r;
+            if (worst == j)
+                return;
+            auto tmp = h(c, j);
+            h(c, j) = h(c, worst);
+            h(c, worst) = tmp;
+            j = worst;
+        }
+    }
+
+    template <class Heaps>
+    KOKKOS_INLINE_FUNCTION void sift_up(const Heaps &h, std::int64_t c, int j)
+    {
+        while (j > 0)
+        {
+            int parent = (j - 1) / 2;
+            if (!better(h(c, parent), h(c, j)))
+                return;
+            auto tmp = h(c, j);
+            h(c, j) = h(c, parent);
+            h(c, parent) = tmp;
+            j = parent;
+        }
+    }
+
+    // The k largest elements of v, best first, 0 < k <= n
+    template <class View>
+    Kokkos::View<Item<typename View::non_const_value_type> *, typename View::execution_space> top_k(const View &v, int k)
+    {
+        using T = typename View::non_const_value_type;
+        using exec = typename View::execution_space;
+        using heaps_type = Kokkos::View<Item<T> **, Kokkos::LayoutRight, exec>;
+        const std::int64_t n = static_cast<std::int64_t>(v.extent(0));
+        if (k <= 0 || k > n)
+            throw std::invalid_argument("selection::top_k: k = " + std::to_string(k) + " outside 1.." + std::to_string(n));
+        const int kept = k;
+        Kokkos::View<Item<T> *, exec> result(Kokkos::view_alloc(Kokkos::WithoutInitializing, "selection::top_k"), kept);
+
+        // A few chunks per thread, each at least a few times larger than k
+        const std::int64_t chunks = std::max<std::int64_t>(1, std::min<std::int64_t>(exec().concurrency() * 4, n / (4 * std::int64_t(kept))));
+        const std::int64_t chunk_len = (n + chunks - 1) / chunks;
+        heaps_type heaps(Kokkos::view_alloc(Kokkos::WithoutInitializing, "selection::heaps"), chunks, kept);
+        heaps_type merged(Kokkos::view_alloc(Kokkos::WithoutInitializing, "selection::merged"), chunks, kept);
+        Kokkos::View<int *, exec> sizes("selection::sizes", chunks);
+
+        Kokkos::parallel_for("selection::chunk_heaps", Kokkos::RangePolicy<exec>(0, chunks), KOKKOS_LAMBDA(std::int64_t c) {
+            const std::int64_t begin = c * chunk_len;
+            const std::int64_t end = begin + chunk_len < n ? begin + chunk_len : n;
+            int size = 0;
+            for (std::int64_t i = begin; i < end; ++i)
+            {
+                Item<T> item{v(i), i};
+                if (size < kept)
+                {
+                    heaps(c, size) = item;
+                    sift_up(heaps, c, size++);
+                }
+                else if (better(item, heaps(c, 0)))
+                {
+                    heaps(c, 0) = item;
+                    sift_down(heaps, c, 0, size);
+                }
+            }
+            // Heap sort: moving the root (worst) to the back leaves the row best first
+            for (int last = size - 1; last > 0; --last)
+            {
+                auto tmp = heaps(c, 0);
+                heaps(c, 0) = heaps(c, last);
+                heaps(c, last) = tmp;
+                sift_down(heaps, c, 0, last);
+            }
+            sizes(c) = size; });
+
+        // Tree merge: row a absorbs row a + stride, keeping the best kept items
+        for (std::int64_t stride = 1; stride < chunks; stride *= 2)
+        {
+            const std::int64_t pairs = (chunks + 2 * stride - 1) / (2 * stride);
+            Kokkos::parallel_for("selection::merge_heaps", Kokkos::RangePolicy<exec>(0, pairs), KOKKOS_LAMBDA(std::int64_t p) {
+                const std::int64_t a = 2 * stride * p, b = a + stride;
+                if (b >= chunks)
+                    return;
+                int ia = 0, ib = 0, out = 0;
+                while (out < kept && (ia < sizes(a) || ib < sizes(b)))
+                {
+                    if (ib >= sizes(b) || (ia < sizes(a) && better(heaps(a, ia), heaps(b, ib))))
+                        merged(a, out++) = heaps(a, ia++);
+                    else
+                        merged(a, out++) = heaps(b, ib++);
+                }
+                for (int j = 0; j < out; ++j)
+                    heaps(a, j) = merged(a, j);
+                sizes(a) = out; });
+        }
+
+        Kokkos::parallel_for("selection::top_k_result", Kokkos::RangePolicy<exec>(0, kept), KOKKOS_LAMBDA(std::int64_t j) { result(j) = heaps(0, j); });
+        return result;
+    }
+
+    // The element of rank k (0-based, 0 <= k < n) in sorted order, like std::nth_element
+    // Candidates shrink to the side of the pivot holding rank k until they fit a serial nth_element
+    template <class View>
+    typename View::non_const_value_type nth_value(const View &v, std::int64_t k)
+    {
+        using T = typename View::non_const_value_type;
+        using exec = typename View::execution_space;
+        using buffer_type = Kokkos::View<T *, exec>;
+        constexpr std::int64_t serial_cutoff = 1 << 14;
+        constexpr int samples = 31;
+
+        std::int64_t n = static_cast<std::int64_t>(v.extent(0));
+        if (k < 0 || k >= n)
+            throw std::invalid_argument("selection::nth_value: rank " + std::to_string(k) + " outside 0.." + std::to_string(n - 1) +
+                                        " (" + std::to_string(n) + " values)");
+        buffer_type a(Kokkos::view_alloc(Kokkos::WithoutInitializing, "selection::candidates"), n);
+        buffer_type b(Kokkos::view_alloc(Kokkos::WithoutInitializing, "selection::candidates_tmp"), n);
+        Kokkos::deep_copy(a, v);
+        Kokkos::View<T *, exec> sample("selection::sample", samples);
+        auto sample_host = Kokkos::create_mirror_view(sample);
+
+        while (n > serial_cutoff)
+        {
+            // Median of evenly spaced samples as pivot
+            const std::int64_t m = n;
+            const buffer_type src = a;
+            Kokkos::parallel_for("selection::sample", Kokkos::RangePolicy<exec>(0, samples), KOKKOS_LAMBDA(std::int64_t s) { sample(s) = src(s * (m - 1) / (samples - 1)); });
+            Kokkos::deep_copy(sample_host, sample);
+            std::nth_element(sample_host.data(), sample_host.data() + samples / 2, sample_host.data() + samples);
+            const T pivot = sample_host(samples / 2);
+
+            const buffer_type dst = b;
+            std::int64_t less = compact::select<exec>(
+                "selection::partition_less", m, KOKKOS_LAMBDA(std::int64_t i) { return src(i) < pivot; },
+                KOKKOS_LAMBDA(std::int64_t i, std::int64_t pos) { dst(pos) = src(i); });
+            if (k < less)
+            {
+                n = less;
+                std::swap(a, b);
+                continue;
+            }
+            std::int64_t equal = 0;
+            Kokkos::parallel_reduce("selection::count_equal", Kokkos::RangePolicy<exec>(0, m), KOKKOS_LAMBDA(std::int64_t i, std::int64_t &update) { update += src(i) == pivot; }, equal);
+            if (k < less + equal)
+                return pivot;
+            n = compact::select<exec>(
+                "selection::partition_greater", m, KOKKOS_LAMBDA(std::int64_t i) { return pivot < src(i); },
+                KOKKOS_LAMBDA(std::int64_t i, std::int64_t pos) { dst(pos) = src(i); });
+            k -= less + equal;
+            std::swap(a, b);
+        }
+
+        std::vector<T> rest(n);
+        Kokkos::View<T *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged> rest_view(rest.data(), n);
+        Kokkos::deep_copy(rest_view, Kokkos::subview(a, Kokkos::make_pair(std::int64_t(0), n)));
+        std::nth_element(rest.begin(), rest.begin() + k, rest.end());
+        return rest[k];
+    }
+
+    // Quantile q in [0, 1] of a non-empty View, linear interpolation between the two closest
+    // ranks (the default of numpy.quantile)
+    template <class View>
+    double quantile(const View &v, double q)
+    {
+        using T = typename View::non_const_value_type;
+        using exec = typename View::execution_space;
+        const std::int64_t n = static_cast<std::int64_t>(v.extent(0));
+        if (n == 0 || !(q >= 0.0 && q <= 1.0))
+            throw std::invalid_argument("selection::quantile: q = " + std::to_string(q) + " of " + std::to_string(n) +
+                                        " values, needs q in [0, 1] and at least one value");
+        const double pos = q * static_cast<double>(n - 1);
+        const std::int64_t k = static_cast<std::int64_t>(pos);
+        const T lo = nth_value(v, k);
+        if (k + 1 >= n || pos == static_cast<double>(k))
+            return static_cast<double>(lo);
+
+        // Rank k + 1 is lo again when lo repeats, otherwise the smallest value above lo
+        std::int64_t not_above = 0;
+        Kokkos::parallel_reduce("selection::count_not_above", Kokkos::RangePolicy<exec>(0, n), KOKKOS_LAMBDA(std::int64_t i, std::int64_t &update) { update += !(lo < v(i)); }, not_above);
+        T hi = lo;
+        if (not_above <= k + 1)
+            Kokkos::parallel_reduce("selection::next_value", Kokkos::RangePolicy<exec>(0, n), KOKKOS_LAMBDA(std::int64_t i, T &update) {
+                if (lo < v(i) && v(i) < update)
+                    update = v(i); }, Kokkos::Min<T>(hi));
+        return static_cast<double>(lo) + (pos - static_cast<double>(k)) * (static_cast<double>(hi) - static_cast<double>(lo));
+    }
+
+    // Order-preserving map to an unsigned integer of the same width
+    template <class T>
+    using radix_type = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::conditional_t<sizeof(T) == 2, std::uint16_t, std::uint8_t>>>;
+
+    template <class T>
+    KOKKOS_INLINE_FUNCTION radix_type<T> radix_key(T x)
+    {
+        using U = radix_type<T>;
+        constexpr U sign = U(1) << (8 * sizeof(T) - 1);
+        U bits;
+        std::memcpy(&bits, &x, sizeof(T));
+        if constexpr (std::is_floating_point_v<T>)
+            return (bits & sign) ? U(~bits) : U(bits | sign); // negatives reversed, positives above them
+        else if constexpr (std::is_signed_v<T>)
+            return bits ^ sign;
+        else
+            return bits;
+    }
+
+    // Stable LSD radix sort of keys, carrying values along when WithValues
+    template <bool WithValues, class KeyView, class ValueView>
+    void radix_sort_impl(const KeyView &keys, const ValueView &values)
+    {
+        using K = typename KeyView::non_const_value_type;
+        using V = typename ValueView::non_const_value_type;
+        using exec = typename KeyView::execution_space;
+        constexpr int radix = 256;
+        constexpr int passes = sizeof(K);
+        static_assert(std::is_arithmetic_v<K>, "radix_sort needs integer or floating point keys");
+
+        const std::int64_t n = static_cast<std::int64_t>(keys.extent(0));
+        const std::int64_t blocks = std::max<std::int64_t>(1, std::min<std::int64_t>(exec().concurrency() * 4, (n + 8191) / 8192));
+        const std::int64_t block_len = (n + blocks - 1) / blocks;
+        Kokkos::View<K *, exec> keys_tmp(Kokkos::view_alloc(Kokkos::WithoutInitializing, "selection::keys_tmp"), n);
+        Kokkos::View<V *, exec> values_tmp(Kokkos::view_alloc(Kokkos::WithoutInitializing, "selection::values_tmp"), WithValues ? n : 0);
+        Kokkos::View<std::int64_t *, exec> offsets("selection::digit_offsets", radix * blocks);
+
+        Kokkos::View<K *, exec> key_src = keys, key_dst = keys_tmp;
+        Kokkos::View<V *, exec> val_src = values, val_dst = values_tmp;
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            const int shift = 8 * pass;
+            Kokkos::deep_copy(offsets, 0);
+            // offsets(d * blocks + b): count of digit d in block b, scanned digit-major so
+            // block b's elements of digit d land after every smaller digit and earlier block
+            Kokkos::parallel_for("selection::radix_histogram", Kokkos::RangePolicy<exec>(0, blocks), KOKKOS_LAMBDA(std::int64_t b) {
+                const std::int64_t end = (b + 1) * block_len < n ? (b + 1) * block_len : n;
+                for (std::int64_t i = b * block_len; i < end; ++i)
+                    offsets(((radix_key(key_src(i)) >> shift) & (radix - 1)) * blocks + b) += 1; });
+            Kokkos::parallel_scan("selection::radix_offsets", Kokkos::RangePolicy<exec>(0, radix * blocks), KOKKOS_LAMBDA(std::int64_t j, std::int64_t &update, bool final) {
+                const std::int64_t count = offsets(j);
+                if (final)
+                    offsets(j) = update;
+                update += count; });
+            Kokkos::parallel_for("selection::radix_scatter", Kokkos::RangePolicy<exec>(0, blocks), KOKKOS_LAMBDA(std::int64_t b) {
+                const std::int64_t end = (b + 1) * block_len < n ? (b + 1) * block_len : n;
+                for (std::int64_t i = b * block_len; i < end; ++i)
+                {
+                    std::int64_t &slot = offsets(((radix_key(key_src(i)) >> shift) & (radix - 1)) * blocks + b);
+                    key_dst(slot) = key_src(i);
+                    if constexpr (WithValues)
+                        val_dst(slot) = val_src(i);
+                    ++slot;
+                } });
+            std::swap(key_src, key_dst);
+            std::swap(val_src, val_dst);
+        }
+        // An odd pass count (1-byte keys) leaves the result in the temporaries
+        if constexpr (passes % 2 == 1)
+        {
+            Kokkos::deep_copy(keys, keys_tmp);
+            if constexpr (WithValues)
+                Kokkos::deep_copy(values, values_tmp);
+        }
+    }
+
+    template <class KeyView>
+    void radix_sort(const KeyView &keys)
+    {
+        radix_sort_impl<false>(keys, Kokkos::View<int *, typename KeyView::execution_space>());
+    }
+
+    template <class KeyView, class ValueView>
+    void sort_by_key(const KeyView &keys, const ValueView &values)
+    {
+        radix_sort_impl<true>(keys, values);
+    }
+}
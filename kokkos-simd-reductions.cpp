@@ -0,0 +1,194 @@
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+#include "kokkos-random.hpp"
+#include "kokkos-simd-reductions.hpp"
+
+// Accuracy and bandwidth of simd_reduce::sum / dot / norm2 against the `double +=`
+// parallel_reduce used in kokkos-parallel-patterns.cpp (Part 4) and kokkos-views.cpp
+// Usage: ./kokkos-simd-reductions [--size N] [--kokkos-num-threads=T] [--json file]
+//   --size is the vector length for the accuracy table and the benchmark (default 16M)
+// The reference is a compensated long double sum computed serially on the host.
+// Run with different --kokkos-num-threads: the simd_reduce columns do not change, bit for bit.
+
+using Vector = Kokkos::View<double *>;
+
+struct Exact
+{
+    long double s = 0.0L;
+    long double c = 0.0L;
+    void add(long double x) { simd_reduce::two_sum(s, c, x); }
+    long double value() const { return s + c; }
+};
+
+template <class Term>
+long double reference(const Vector &x, const Vector &y, Term term)
+{
+    auto hx = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x);
+    auto hy = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y);
+    Exact e;
+    for (std::size_t i = 0; i < hx.extent(0); ++i)
+        e.add(term(static_cast<long double>(hx(i)), static_cast<long double>(hy(i))));
+    return e.value();
+}
+
+double relative_error(double value, long double exact)
+{
+    return static_cast<double>(std::fabs((static_cast<long double>(value) - exact) / exact));
+}
+
+double parallel_reduce_sum(const Vector &x)
+{
+    double sum = 0;
+    Kokkos::parallel_reduce("sum_x", x.extent(0), KOKKOS_LAMBDA(int i, double &tempSum) { tempSum += x(i); }, sum);
+    return sum;
+}
+
+double parallel_reduce_dot(const Vector &x, const Vector &y)
+{
+    double dot = 0;
+    Kokkos::parallel_reduce("dot_x_y", x.extent(0), KOKKOS_LAMBDA(int i, double &tempDot) { tempDot += x(i) * y(i); }, dot);
+    return dot;
+}
+
+double parallel_reduce_norm2(const Vector &x)
+{
+    double sum = 0;
+    Kokkos::parallel_reduce("norm2_x", x.extent(0), KOKKOS_LAMBDA(int i, double &tempSum) { tempSum += x(i) * x(i); }, sum);
+    return std::sqrt(sum);
+}
+
+// One row of the accuracy table; the simd_reduce results must be reproducible run to run
+// and the compensated one must not be less accurate than the parallel_reduce
+template <class Current, class Plain, class Compensated>
+bool accuracy(const std::string &what, long double exact, Current current, Plain plain, Compensated compensated)
+{
+    const double c = current(), p = plain(), k = compensated();
+    const double ec = relative_error(c, exact), ep = relative_error(p, exact), ek = relative_error(k, exact);
+    std::printf("  %-34s %12.3e %12.3e %12.3e\n", what.c_str(), ec, ep, ek);
+    const bool reproducible = plain() == p && compensated() == k;
+    const bool accurate = ek <= std::max(ec, 4 * DBL_EPSILON);
+    if (!reproducible)
+        std::cout << "[FAIL] " << what << ": simd_reduce result changed between runs\n";
+    if (!accurate)
+        std::cout << "[FAIL] " << what << ": compensated result less accurate than parallel_reduce\n";
+    return reproducible && accurate;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    std::int64_t n = 1 << 24;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--size")
+            n = std::atoll(argv[i + 1]);
+
+    using simd_reduce::Mode;
+    random_fill::Filler<> random(2024);
+    Vector x("x", n), y("y", n), wide("wide", n), tail("tail", n + 3);
+    random.uniform(x, 0.0, 1.0);
+    random.normal(y, 0.0, 1.0);
+    // Magnitudes spread over 2^-20 .. 2^20 with random signs: heavy cancellation
+    Kokkos::View<int *> exponent("exponent", n);
+    random.uniform(wide, -1.0, 1.0);
+    random.integer(exponent, -20, 21);
+    Kokkos::parallel_for("scale_wide", n, KOKKOS_LAMBDA(std::int64_t i) { wide(i) *= Kokkos::pow(2.0, exponent(i)); });
+    random.normal(tail, 0.0, 1.0);
+    Vector tail_y("tail_y", n + 3);
+    random.uniform(tail_y, -1.0, 1.0);
+
+    std::cout << "\n=== Relative error against a compensated long double sum, n = " << n << " ===\n";
+    std::printf("  %-34s %12s %12s %12s\n", "", "reduce +=", "simd plain", "simd comp.");
+    auto id = [](long double a, long double) { return a; };
+    auto prod = [](long double a, long double b) { return a * b; };
+    auto square = [](long double a, long double) { return a * a; };
+    bool ok = true;
+    ok &= accuracy("sum uniform [0, 1)", reference(x, x, id), [&]
+                   { return parallel_reduce_sum(x); }, [&]
+                   { return simd_reduce::sum<Mode::plain>(x); }, [&]
+                   { return simd_reduce::sum(x); });
+    ok &= accuracy("sum 2^-20 .. 2^20, random signs", reference(wide, wide, id), [&]
+                   { return parallel_reduce_sum(wide); }, [&]
+                   { return simd_reduce::sum<Mode::plain>(wide); }, [&]
+                   { return simd_reduce::sum(wide); });
+    ok &= accuracy("dot uniform . normal", reference(x, y, prod), [&]
+                   { return parallel_reduce_dot(x, y); }, [&]
+                   { return simd_reduce::dot<Mode::plain>(x, y); }, [&]
+                   { return simd_reduce::dot(x, y); });
+    ok &= accuracy("dot n + 3 (scalar tail)", reference(tail, tail_y, prod), [&]
+                   { return parallel_reduce_dot(tail, tail_y); }, [&]
+                   { return simd_reduce::dot<Mode::plain>(tail, tail_y); }, [&]
+                   { return simd_reduce::dot(tail, tail_y); });
+    ok &= accuracy("norm2 normal", std::sqrt(reference(y, y, square)), [&]
+                   { return parallel_reduce_norm2(y); }, [&]
+                   { return simd_reduce::norm2<Mode::plain>(y); }, [&]
+                   { return simd_reduce::norm2(y); });
+
+    // Rank 2: the Frobenius norm runs over the span
+    Kokkos::View<double **> C("C", 100, 100);
+    Kokkos::parallel_for("fill_C", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {100, 100}), KOKKOS_LAMBDA(int i, int j) { C(i, j) = (i + j) + i * j; });
+    long double frobenius = 0.0L;
+    for (int i = 0; i < 100; ++i)
+        for (int j = 0; j < 100; ++j)
+            frobenius += static_cast<long double>((i + j) + i * j) * ((i + j) + i * j); // exact in long double
+    frobenius = std::sqrt(frobenius);
+    const double frobenius_error = relative_error(simd_reduce::norm2(C), frobenius);
+    const bool frobenius_ok = frobenius_error <= 2 * DBL_EPSILON;
+    std::cout << (frobenius_ok ? "[PASS] " : "[FAIL] ") << "Frobenius norm of a 100x100 View (relative error " << frobenius_error << ")\n";
+    ok &= frobenius_ok;
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << "simd_reduce reproducible and at least as accurate as parallel_reduce\n";
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const double bytes = double(n) * sizeof(double);
+    const std::string size = " " + std::to_string(n);
+    runner.run(
+        "sum parallel_reduce +=" + size, [&]()
+        { bench::DoNotOptimize(parallel_reduce_sum(x)); },
+        bytes);
+    runner.run(
+        "sum simd plain" + size, [&]()
+        { bench::DoNotOptimize(simd_reduce::sum<Mode::plain>(x)); },
+        bytes);
+    runner.run(
+        "sum simd compensated" + size, [&]()
+        { bench::DoNotOptimize(simd_reduce::sum(x)); },
+        bytes);
+    runner.run(
+        "dot parallel_reduce +=" + size, [&]()
+        { bench::DoNotOptimize(parallel_reduce_dot(x, y)); },
+        2 * bytes);
+    runner.run(
+        "dot simd plain" + size, [&]()
+        { bench::DoNotOptimize(simd_reduce::dot<Mode::plain>(x, y)); },
+        2 * bytes);
+    runner.run(
+        "dot simd compensated" + size, [&]()
+        { bench::DoNotOptimize(simd_reduce::dot(x, y)); },
+        2 * bytes);
+    runner.run(
+        "norm2 parallel_reduce +=" + size, [&]()
+        { bench::DoNotOptimize(parallel_reduce_norm2(y)); },
+        bytes);
+    runner.run(
+        "norm2 simd plain" + size, [&]()
+        { bench::DoNotOptimize(simd_reduce::norm2<Mode::plain>(y)); },
+        bytes);
+    runner.run(
+        "norm2 simd compensated" + size, [&]()
+        { bench::DoNotOptimize(simd_reduce::norm2(y)); },
+        bytes);
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
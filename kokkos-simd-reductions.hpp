@@ -0,0 +1,193 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_SIMD.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// SIMD sum / dot / norm2 of contiguous double Views, plain or compensated
+// A `double +=` parallel_reduce loses accuracy at large n (every partial sum rounds) and its
+// result depends on how the backend splits and joins the range, so it changes with the thread
+// count. Here the data is cut into fixed blocks of `block` elements. Each block is reduced with
+// Kokkos::Experimental::native_simd and `Unroll` independent accumulators (hides the add latency),
+// and the per-block partials are combined on the host in block order. Every addition happens in an
+// order that depends only on n and block, so results are bitwise reproducible for any thread count.
+// Mode::compensated keeps the rounding error of every addition in a second accumulator
+// (branch-free TwoSum, as accurate as Neumaier's variant of Kahan summation), which makes the
+// error independent of n for the summation; dot products still round each product.
+//
+//   double d = simd_reduce::dot(a, b);                                    // compensated
+//   double s = simd_reduce::sum<simd_reduce::Mode::plain>(x);
+//   double f = simd_reduce::norm2(C);                                     // Frobenius norm of a rank-2 View
+namespace simd_reduce
+{
+    enum class Mode
+    {
+        plain,
+        compensated
+    };
+
+    // s + c += x, with the rounding error of s + x added to c
+    template <class T>
+    KOKKOS_INLINE_FUNCTION void two_sum(T &s, T &c, const T &x)
+    {
+        const T t = s + x;
+        const T z = t - s;
+        c += (s - (t - z)) + (x - z);
+        s = t;
+    }
+
+    template <Mode M, class T>
+    struct Accumulator
+    {
+        T s = T(0.0);
+        T c = T(0.0);
+
+        KOKKOS_INLINE_FUNCTION void add(const T &x)
+        {
+            if constexpr (M == Mode::plain)
+                s += x;
+            else
+                two_sum(s, c, x);
+        }
+    };
+
+    // Terms of the three reductions, as SIMD vectors at i (i + lane) or scalars for the tail
+    struct SumTerm
+    {
+        const double *x;
+        template <class V>
+        KOKKOS_INLINE_FUNCTION V load(std::int64_t i) const
+        {
+            V v;
+            v.copy_from(x + i, Kokkos::Experimental::simd_flag_default);
+            return v;
+        }
+        KOKKOS_INLINE_FUNCTION double at(std::int64_t i) const { return x[i]; }
+    };
+
+    struct SquareTerm
+    {
+        const double *x;
+        template <class V>
+        KOKKOS_INLINE_FUNCTION V load(std::int64_t i) const
+        {
+            V v;
+            v.copy_from(x + i, Kokkos::Experimental::simd_flag_default);
+            return v * v;
+        }
+        KOKKOS_INLINE_FUNCTION double at(std::int64_t i) const { return x[i] * x[i]; }
+    };
+
+    struct DotTerm
+    {
+        const double *x;
+        const double *y;
+        template <class V>
+        KOKKOS_INLINE_FUNCTION V load(std::int64_t i) const
+        {
+            V a, b;
+            a.copy_from(x + i, Kokkos::Experimental::simd_flag_default);
+            b.copy_from(y + i, Kokkos::Experimental::simd_flag_default);
+            return a * b;
+        }
+        KOKKOS_INLINE_FUNCTION double at(std::int64_t i) const { return x[i] * y[i]; }
+    };
+
+    // Sum of term over [0, n): one SIMD pass per block, then the partials in block order
+    template <Mode M, int Unroll = 4, class ExecSpace = Kokkos::DefaultExecutionSpace, class Term>
+    double reduce(const char *label, std::int64_t n, const Term &term, std::int64_t block = 1 << 16)
+    {
+        using simd = Kokkos::Experimental::native_simd<double>;
+        constexpr std::int64_t width = static_cast<std::int64_t>(simd::size());
+        constexpr std::int64_t stride = width * Unroll;
+        if (block <= 0 || block % stride != 0)
+            throw std::invalid_argument("simd_reduce: block must be a positive multiple of " + std::to_string(stride));
+
+        const std::int64_t blocks = (n + block - 1) / block;
+        Kokkos::View<double *, ExecSpace> sums(Kokkos::view_alloc(Kokkos::WithoutInitializing, "simd_reduce::sums"), blocks);
+        Kokkos::View<double *, ExecSpace> errors(Kokkos::view_alloc(Kokkos::WithoutInitializing, "simd_reduce::errors"), blocks);
+        Kokkos::parallel_for(label, Kokkos::RangePolicy<ExecSpace>(0, blocks), KOKKOS_LAMBDA(std::int64_t b) {
+            const std::int64_t begin = b * block;
+            const std::int64_t end = begin + block < n ? begin + block : n;
+            const std::int64_t vector_end = begin + (end - begin) / stride * stride;
+
+            Accumulator<M, simd> acc[Unroll];
+            for (std::int64_t i = begin; i < vector_end; i += stride)
+                for (int u = 0; u < Unroll; ++u)
+                    acc[u].add(term.template load<simd>(i + u * width));
+
+            // Accumulators, then lanes, in a fixed order
+            double s = 0.0, c = 0.0;
+            for (int u = 0; u < Unroll; ++u)
+                for (std::int64_t lane = 0; lane < width; ++lane)
+                {
+                    two_sum(s, c, double(acc[u].s[lane]));
+                    c += acc[u].c[lane];
+                }
+            for (std::int64_t i = vector_end; i < end; ++i)
+            {
+                if constexpr (M == Mode::plain)
+                    s += term.at(i);
+                else
+                    two_sum(s, c, term.at(i));
+            }
+            sums(b) = s;
+            errors(b) = c; });
+
+        auto host_sums = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), sums);
+        auto host_errors = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), errors);
+        double s = 0.0, c = 0.0;
+        for (std::int64_t b = 0; b < blocks; ++b)
+        {
+            if constexpr (M == Mode::plain)
+                s += host_sums(b);
+            else
+            {
+                two_sum(s, c, host_sums(b));
+                c += host_errors(b);
+            }
+        }
+        return s + c;
+    }
+
+    template <class View>
+    const double *contiguous_data(const View &v)
+    {
+        static_assert(std::is_same_v<typename View::non_const_value_type, double>, "simd_reduce works on double Views");
+        if (!v.span_is_contiguous())
+            throw std::invalid_argument("simd_reduce: View " + v.label() + " is not contiguous");
+        return v.data();
+    }
+
+    // Any rank: the reductions run over the View's span, e.g. norm2 of a matrix is its Frobenius norm
+    template <Mode M = Mode::compensated, class View>
+    double sum(const View &x)
+    {
+        using exec = typename View::execution_space;
+        return reduce<M, 4, exec>("simd_reduce::sum", static_cast<std::int64_t>(x.span()), SumTerm{contiguous_data(x)});
+    }
+
+    // x and y are paired element by element through their spans, so they need the same rank,
+    // extents and layout (a LayoutLeft matrix against a LayoutRight one would pair x(i, j) with y(j, i))
+    template <Mode M = Mode::compensated, class ViewX, class ViewY>
+    double dot(const ViewX &x, const ViewY &y)
+    {
+        using exec = typename ViewX::execution_space;
+        static_assert(ViewX::rank == ViewY::rank, "simd_reduce::dot: Views of different rank");
+        static_assert(std::is_same_v<typename ViewX::array_layout, typename ViewY::array_layout>, "simd_reduce::dot: Views of different layouts");
+        for (int r = 0; r < static_cast<int>(ViewX::rank); ++r)
+            if (x.extent(r) != y.extent(r))
+                throw std::invalid_argument("simd_reduce::dot: " + x.label() + " and " + y.label() + " differ in extent " + std::to_string(r));
+        return reduce<M, 4, exec>("simd_reduce::dot", static_cast<std::int64_t>(x.span()), DotTerm{contiguous_data(x), contiguous_data(y)});
+    }
+
+    template <Mode M = Mode::compensated, class View>
+    double norm2(const View &x)
+    {
+        using exec = typename View::execution_space;
+        return Kokkos::sqrt(reduce<M, 4, exec>("simd_reduce::norm2", static_cast<std::int64_t>(x.span()), SquareTerm{contiguous_data(x)}));
+    }
+}
@@ -0,0 +1,255 @@
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "kokkos-sparse.hpp"
+
+// CRS assembly and SpMV checked against host references, then SpMV GFLOP/s and bandwidth
+// against the dense matrix-vector product on the same matrix
+// Usage: ./kokkos-sparse [--grid G] [--matrix file.mtx] [--kokkos-num-threads=T] [--json file]
+//   --grid: side of the 2D 5-point Laplacian used for the large sparse run (default 1024, n = G^2)
+//   --matrix: also benchmark SpMV on a local Matrix Market file
+
+using Matrix = sparse::CrsMatrix<>;
+
+// 5-point Laplacian on a g x g grid as shuffled COO triplets, the diagonal split in two
+// halves so the assembly has duplicates to merge
+void laplacian_coo(int g, std::vector<int> &r, std::vector<int> &c, std::vector<double> &v)
+{
+    for (int i = 0; i < g; ++i)
+        for (int j = 0; j < g; ++j)
+        {
+            int p = i * g + j;
+            r.insert(r.end(), {p, p}), c.insert(c.end(), {p, p}), v.insert(v.end(), {2.0, 2.0});
+            const int di[] = {-1, 1, 0, 0}, dj[] = {0, 0, -1, 1};
+            for (int d = 0; d < 4; ++d)
+                if (i + di[d] >= 0 && i + di[d] < g && j + dj[d] >= 0 && j + dj[d] < g)
+                    r.push_back(p), c.push_back((i + di[d]) * g + j + dj[d]), v.push_back(-1.0);
+        }
+    std::vector<std::size_t> order(r.size());
+    for (std::size_t k = 0; k < order.size(); ++k)
+        order[k] = k;
+    std::shuffle(order.begin(), order.end(), std::mt19937(2024));
+    std::vector<int> r2(r.size()), c2(r.size());
+    std::vector<double> v2(r.size());
+    for (std::size_t k = 0; k < order.size(); ++k)
+        r2[k] = r[order[k]], c2[k] = c[order[k]], v2[k] = v[order[k]];
+    r.swap(r2), c.swap(c2), v.swap(v2);
+}
+
+Matrix assemble(int n, const std::vector<int> &r, const std::vector<int> &c, const std::vector<double> &v)
+{
+    const std::int64_t count = static_cast<std::int64_t>(r.size());
+    Kokkos::View<int *> rows("rows", count), cols("cols", count);
+    Kokkos::View<double *> vals("vals", count);
+    auto rows_host = Kokkos::create_mirror_view(rows);
+    auto cols_host = Kokkos::create_mirror_view(cols);
+    auto vals_host = Kokkos::create_mirror_view(vals);
+    for (std::int64_t k = 0; k < count; ++k)
+        rows_host(k) = r[k], cols_host(k) = c[k], vals_host(k) = v[k];
+    Kokkos::deep_copy(rows, rows_host);
+    Kokkos::deep_copy(cols, cols_host);
+    Kokkos::deep_copy(vals, vals_host);
+    return sparse::from_coo(n, n, rows, cols, vals);
+}
+
+bool report(const std::string &what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+// Compares the assembled matrix with a std::map built from the same triplets
+bool check_assembly(const Matrix &A, const std::vector<int> &r, const std::vector<int> &c, const std::vector<double> &v)
+{
+    std::vector<std::map<int, double>> ref(A.num_rows);
+    for (std::size_t k = 0; k < r.size(); ++k)
+        ref[r[k]][c[k]] += v[k];
+    auto row_map = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.row_map);
+    auto entries = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.entries);
+    auto values = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A.values);
+    for (int i = 0; i < A.num_rows; ++i)
+    {
+        if (row_map(i + 1) - row_map(i) != static_cast<std::int64_t>(ref[i].size()))
+            return false;
+        std::int64_t k = row_map(i);
+        for (const auto &[col, value] : ref[i])
+        {
+            if (entries(k) != col || values(k) != value)
+                return false;
+            ++k;
+        }
+    }
+    return true;
+}
+
+double max_difference(const Kokkos::View<double *> &a, const Kokkos::View<double *> &b)
+{
+    double diff = 0;
+    Kokkos::parallel_reduce("max_difference", a.extent(0), KOKKOS_LAMBDA(int i, double &update) { update = Kokkos::fmax(update, Kokkos::fabs(a(i) - b(i))); }, Kokkos::Max<double>(diff));
+    return diff;
+}
+
+// y = A x on the dense matrix, one row per iteration
+void dense_matvec(const Kokkos::View<double **> &A, const Kokkos::View<double *> &x, const Kokkos::View<double *> &y)
+{
+    const int n = static_cast<int>(A.extent(1));
+    Kokkos::parallel_for("dense_matvec", A.extent(0), KOKKOS_LAMBDA(int i) {
+        double sum = 0;
+        for (int j = 0; j < n; ++j)
+            sum += A(i, j) * x(j);
+        y(i) = sum; });
+}
+
+Kokkos::View<double **> to_dense(const Matrix &A)
+{
+    Kokkos::View<double **> dense("dense", A.num_rows, A.num_cols);
+    auto row_map = A.row_map;
+    auto entries = A.entries;
+    auto values = A.values;
+    Kokkos::parallel_for("to_dense", A.num_rows, KOKKOS_LAMBDA(int i) {
+        for (std::int64_t k = row_map(i); k < row_map(i + 1); ++k)
+            dense(i, entries(k)) = values(k); });
+    return dense;
+}
+
+// Bytes moved by one SpMV: values and column indices once, the row map, x and y at least once
+double spmv_bytes(const Matrix &A)
+{
+    return double(A.nnz()) * (sizeof(double) + sizeof(int)) + double(A.num_rows + 1) * sizeof(std::int64_t) + double(A.num_cols + A.num_rows) * sizeof(double);
+}
+
+void print_rate(const bench::Runner &runner, const std::string &name, double flops)
+{
+    for (const auto &r : runner.results())
+        if (r.name == name)
+            std::printf("  %-40s %8.3f GFLOP/s\n", name.c_str(), flops / r.median_ns);
+}
+
+bool check_matrix_market()
+{
+    const auto path = std::filesystem::temp_directory_path() / "kokkos-sparse-check.mtx";
+    {
+        std::ofstream out(path);
+        out << "%%MatrixMarket matrix coordinate real symmetric\n"
+            << "% 3x3, lower triangle stored\n"
+            << "3 3 4\n"
+            << "1 1 4.0\n2 1 -1.0\n2 2 4.0\n3 3 2.5\n";
+    }
+    Matrix A = sparse::read_matrix_market(path.string());
+    auto dense = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), to_dense(A));
+    const double expected[3][3] = {{4.0, -1.0, 0.0}, {-1.0, 4.0, 0.0}, {0.0, 0.0, 2.5}};
+    bool ok = A.num_rows == 3 && A.nnz() == 5;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            ok &= dense(i, j) == expected[i][j];
+
+    // A row index past the size line is an error, not an out-of-bounds write in from_coo
+    {
+        std::ofstream out(path);
+        out << "%%MatrixMarket matrix coordinate real general\n3 3 1\n4 1 1.0\n";
+    }
+    bool rejected = false;
+    try
+    {
+        sparse::read_matrix_market(path.string());
+    }
+    catch (const std::runtime_error &)
+    {
+        rejected = true;
+    }
+    std::filesystem::remove(path);
+    return ok && rejected;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    int grid = 1024;
+    std::string matrix_file;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--grid")
+            grid = std::atoi(argv[i + 1]);
+        else if (std::string(argv[i]) == "--matrix")
+            matrix_file = argv[i + 1];
+    }
+
+    std::cout << "\n=== Verification ===\n";
+    bool ok = report("Matrix Market reader (symmetric, comments, index out of range)", check_matrix_market());
+
+    // Small Laplacian: assembly, SpMV and the dense path agree
+    const int g_small = 64, n_small = g_small * g_small;
+    std::vector<int> r, c;
+    std::vector<double> v;
+    laplacian_coo(g_small, r, c, v);
+    Matrix A = assemble(n_small, r, c, v);
+    ok &= report("from_coo matches host assembly (" + std::to_string(A.nnz()) + " nnz, duplicates merged)", check_assembly(A, r, c, v));
+
+    Kokkos::View<double *> x("x", n_small), y_sparse("y_sparse", n_small), y_dense("y_dense", n_small);
+    Kokkos::parallel_for("fill_x", n_small, KOKKOS_LAMBDA(int i) { x(i) = 1.0 + (i % 17) * 0.25; });
+    Kokkos::View<double **> dense = to_dense(A);
+    sparse::spmv(A, x, y_sparse);
+    dense_matvec(dense, x, y_dense);
+    ok &= report("spmv matches dense matvec", max_difference(y_sparse, y_dense) < 1e-12);
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const std::string sparse_small = "spmv laplacian n=" + std::to_string(n_small);
+    const std::string dense_small = "dense matvec n=" + std::to_string(n_small);
+    runner.run(
+        sparse_small, [&]()
+        { sparse::spmv(A, x, y_sparse); Kokkos::fence(); },
+        spmv_bytes(A));
+    runner.run(
+        dense_small, [&]()
+        { dense_matvec(dense, x, y_dense); Kokkos::fence(); },
+        double(n_small) * n_small * sizeof(double) + 2.0 * n_small * sizeof(double));
+    std::cout << "  memory: CRS " << spmv_bytes(A) / 1e6 << " MB, dense " << double(n_small) * n_small * sizeof(double) / 1e6 << " MB\n";
+    print_rate(runner, sparse_small, 2.0 * A.nnz());
+    print_rate(runner, dense_small, 2.0 * n_small * n_small);
+
+    // Large Laplacian, sparse only (the dense matrix would need n^2 * 8 bytes)
+    r.clear(), c.clear(), v.clear();
+    laplacian_coo(grid, r, c, v);
+    const int n_large = grid * grid;
+    Matrix L = assemble(n_large, r, c, v);
+    Kokkos::View<double *> xl("xl", n_large), yl("yl", n_large);
+    Kokkos::deep_copy(xl, 1.0);
+    const std::string sparse_large = "spmv laplacian n=" + std::to_string(n_large);
+    runner.run(
+        sparse_large, [&]()
+        { sparse::spmv(L, xl, yl); Kokkos::fence(); },
+        spmv_bytes(L));
+    print_rate(runner, sparse_large, 2.0 * L.nnz());
+
+    if (!matrix_file.empty())
+    {
+        Matrix M = sparse::read_matrix_market(matrix_file);
+        Kokkos::View<double *> xm("xm", M.num_cols), ym("ym", M.num_rows);
+        Kokkos::deep_copy(xm, 1.0);
+        const std::string name = "spmv " + std::filesystem::path(matrix_file).filename().string();
+        std::cout << "  " << matrix_file << ": " << M.num_rows << " x " << M.num_cols << ", " << M.nnz() << " nnz\n";
+        runner.run(
+            name, [&]()
+            { sparse::spmv(M, xm, ym); Kokkos::fence(); },
+            spmv_bytes(M));
+        print_rate(runner, name, 2.0 * M.nnz());
+    }
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compressed sparse row (CRS) matrices on Kokkos Views
+// Row r holds the entries row_map(r) .. row_map(r + 1) of entries (column indices, sorted,
+// no duplicates) and values. A matrix with nnz non-zeros takes nnz * (4 + 8) + (rows + 1) * 8
+// bytes instead of rows * cols * 8 for the dense View<double **>.
+// - from_coo: parallel assembly from (row, col, value) triplets in any order, duplicates summed
+// - spmv: y = A x, one team per block of rows, one row per team thread, the entries of a row
+//   split across the vector lanes
+// - read_matrix_market: coordinate real / integer / pattern, general or symmetric
+namespace sparse
+{
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace>
+    struct CrsMatrix
+    {
+        using execution_space = ExecSpace;
+        using row_map_type = Kokkos::View<std::int64_t *, ExecSpace>;
+        using entries_type = Kokkos::View<int *, ExecSpace>;
+        using values_type = Kokkos::View<double *, ExecSpace>;
+
+        int num_rows = 0;
+        int num_cols = 0;
+        row_map_type row_map;
+        entries_type entries;
+        values_type values;
+
+        std::int64_t nnz() const { return static_cast<std::int64_t>(entries.extent(0)); }
+    };
+
+    // Assembly from COO triplets with a counting sort by row (atomic histogram + scan + scatter),
+    // a per-row sort by column, and a second scan that merges duplicate (row, col) entries.
+    // Rows are sorted with an insertion sort, which is the right tool for the short rows of
+    // typical sparse matrices and quadratic for very long ones.
+    // Throws std::invalid_argument when the Views differ in length or a triplet lies outside
+    // num_rows x num_cols (checked in one counting pass before anything is written).
+    template <class RowView, class ColView, class ValView>
+    CrsMatrix<typename RowView::execution_space> from_coo(int num_rows, int num_cols, const RowView &rows, const ColView &cols, const ValView &vals)
+    {
+        using ExecSpace = typename RowView::execution_space;
+        using policy = Kokkos::RangePolicy<ExecSpace>;
+        const std::int64_t n = static_cast<std::int64_t>(rows.extent(0));
+        if (num_rows < 0 || num_cols < 0 || cols.extent(0) != rows.extent(0) || vals.extent(0) != rows.extent(0))
+            throw std::invalid_argument("sparse::from_coo: negative size or triplet Views of different lengths");
+        std::int64_t outside = 0;
+        Kokkos::parallel_reduce("sparse::check_coo", policy(0, n), KOKKOS_LAMBDA(std::int64_t k, std::int64_t &update) {
+            update += rows(k) < 0 || rows(k) >= num_rows || cols(k) < 0 || cols(k) >= num_cols; }, outside);
+        if (outside > 0)
+            throw std::invalid_argument("sparse::from_coo: " + std::to_string(outside) + " triplets outside the " +
+                                        std::to_string(num_rows) + " x " + std::to_string(num_cols) + " matrix");
+
+        // Counting sort by row
+        Kokkos::View<std::int64_t *, ExecSpace> offsets("sparse::offsets", num_rows + 1);
+        Kokkos::parallel_for("sparse::row_counts", policy(0, n), KOKKOS_LAMBDA(std::int64_t k) { Kokkos::atomic_add(&offsets(rows(k) + 1), std::int64_t(1)); });
+        Kokkos::parallel_scan("sparse::row_offsets", policy(0, num_rows + 1), KOKKOS_LAMBDA(std::int64_t r, std::int64_t &update, bool final) {
+            update += offsets(r);
+            if (final)
+                offsets(r) = update; });
+
+        Kokkos::View<std::int64_t *, ExecSpace> cursor(Kokkos::view_alloc(Kokkos::WithoutInitializing, "sparse::cursor"), num_rows);
+        Kokkos::parallel_for("sparse::cursor", policy(0, num_rows), KOKKOS_LAMBDA(std::int64_t r) { cursor(r) = offsets(r); });
+        Kokkos::View<int *, ExecSpace> sorted_cols(Kokkos::view_alloc(Kokkos::WithoutInitializing, "sparse::sorted_cols"), n);
+        Kokkos::View<double *, ExecSpace> sorted_vals(Kokkos::view_alloc(Kokkos::WithoutInitializing, "sparse::sorted_vals"), n);
+        Kokkos::parallel_for("sparse::scatter_rows", policy(0, n), KOKKOS_LAMBDA(std::int64_t k) {
+            std::int64_t pos = Kokkos::atomic_fetch_add(&cursor(rows(k)), std::int64_t(1));
+            sorted_cols(pos) = cols(k);
+            sorted_vals(pos) = vals(k); });
+
+        // Sort each row by column and count its distinct columns
+        Kokkos::View<std::int64_t *, ExecSpace> row_map("sparse::row_map", num_rows + 1);
+        Kokkos::parallel_for("sparse::sort_rows", policy(0, num_rows), KOKKOS_LAMBDA(std::int64_t r) {
+            const std::int64_t begin = offsets(r), end = offsets(r + 1);
+            for (std::int64_t k = begin + 1; k < end; ++k)
+            {
+                const int c = sorted_cols(k);
+                const double v = sorted_vals(k);
+                std::int64_t m = k;
+                for (; m > begin && sorted_cols(m - 1) > c; --m)
+                {
+                    sorted_cols(m) = sorted_cols(m - 1);
+                    sorted_vals(m) = sorted_vals(m - 1);
+                }
+                sorted_cols(m) = c;
+                sorted_vals(m) = v;
+            }
+            std::int64_t distinct = 0;
+            for (std::int64_t k = begin; k < end; ++k)
+                distinct += (k == begin || sorted_cols(k) != sorted_cols(k - 1));
+            row_map(r + 1) = distinct; });
+
+        std::int64_t nnz = 0;
+        Kokkos::parallel_scan("sparse::row_map", policy(0, num_rows + 1), KOKKOS_LAMBDA(std::int64_t r, std::int64_t &update, bool final) {
+            update += row_map(r);
+            if (final)
+                row_map(r) = update; }, nnz);
+
+        CrsMatrix<ExecSpace> A;
+        A.num_rows = num_rows;
+        A.num_cols = num_cols;
+        A.row_map = row_map;
+        A.entries = typename CrsMatrix<ExecSpace>::entries_type(Kokkos::view_alloc(Kokkos::WithoutInitializing, "sparse::entries"), nnz);
+        A.values = typename CrsMatrix<ExecSpace>::values_type("sparse::values", nnz);
+        auto entries = A.entries;
+        auto values = A.values;
+        Kokkos::parallel_for("sparse::merge_duplicates", policy(0, num_rows), KOKKOS_LAMBDA(std::int64_t r) {
+            std::int64_t out = row_map(r) - 1;
+            for (std::int64_t k = offsets(r); k < offsets(r + 1); ++k)
+            {
+                if (k == offsets(r) || sorted_cols(k) != sorted_cols(k - 1))
+                {
+                    ++out;
+                    entries(out) = sorted_cols(k);
+                }
+                values(out) += sorted_vals(k);
+            } });
+        return A;
+    }
+
+    // Vector length from the average row length: a power of two, at most the backend maximum
+    template <class ExecSpace>
+    int spmv_vector_length(const CrsMatrix<ExecSpace> &A)
+    {
+        const std::int64_t avg = A.num_rows > 0 ? A.nnz() / A.num_rows : 1;
+        int vector_length = 1;
+        while (vector_length * 2 <= avg && vector_length < 32)
+            vector_length *= 2;
+        const int max = Kokkos::TeamPolicy<ExecSpace>::vector_length_max();
+        return vector_length < max ? vector_length : max;
+    }
+
+    // y = A x
+    template <class ExecSpace, class XView, class YView>
+    void spmv(const CrsMatrix<ExecSpace> &A, const XView &x, const YView &y, int rows_per_team = 64)
+    {
+        using policy = Kokkos::TeamPolicy<ExecSpace>;
+        using member = typename policy::member_type;
+        const int num_rows = A.num_rows;
+        const auto row_map = A.row_map;
+        const auto entries = A.entries;
+        const auto values = A.values;
+        const int league = (num_rows + rows_per_team - 1) / rows_per_team;
+
+        Kokkos::parallel_for("sparse::spmv", policy(league, Kokkos::AUTO, spmv_vector_length(A)), KOKKOS_LAMBDA(const member &team) {
+            const int first = team.league_rank() * rows_per_team;
+            const int last = first + rows_per_team < num_rows ? first + rows_per_team : num_rows;
+            Kokkos::parallel_for(Kokkos::TeamThreadRange(team, first, last), [&](int r) {
+                double sum = 0.0;
+                Kokkos::parallel_reduce(Kokkos::ThreadVectorRange(team, row_map(r), row_map(r + 1)), [&](std::int64_t k, double &update) {
+                    update += values(k) * x(entries(k)); }, sum);
+                Kokkos::single(Kokkos::PerThread(team), [&]() { y(r) = sum; }); }); });
+    }
+
+    // Matrix Market coordinate format, 1-based indices; symmetric files store one triangle,
+    // the other is mirrored here. Throws std::runtime_error on unreadable or unsupported files,
+    // and on sizes or indices out of range.
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace>
+    CrsMatrix<ExecSpace> read_matrix_market(const std::string &path)
+    {
+        std::ifstream in(path);
+        if (!in)
+            throw std::runtime_error("Cannot open matrix file " + path);
+
+        std::string line;
+        std::getline(in, line);
+        std::istringstream banner(line);
+        std::string tag, object, format, field, symmetry;
+        banner >> tag >> object >> format >> field >> symmetry;
+        if (tag != "%%MatrixMarket" || object != "matrix" || format != "coordinate")
+            throw std::runtime_error("Unsupported Matrix Market file (coordinate matrices only): " + path);
+        if (field != "real" && field != "integer" && field != "pattern")
+            throw std::runtime_error("Unsupported Matrix Market field " + field + ": " + path);
+        const bool pattern = field == "pattern";
+        const bool symmetric = symmetry == "symmetric" || symmetry == "skew-symmetric";
+        const double mirror_sign = symmetry == "skew-symmetric" ? -1.0 : 1.0;
+
+        while (std::getline(in, line) && (line.empty() || line[0] == '%'))
+            ;
+        int num_rows = 0, num_cols = 0;
+        std::int64_t count = 0;
+        if (!(std::istringstream(line) >> num_rows >> num_cols >> count) || num_rows < 0 || num_cols < 0 || count < 0)
+            throw std::runtime_error("Bad Matrix Market size line: " + path);
+
+        std::vector<int> r, c;
+        std::vector<double> v;
+        r.reserve(symmetric ? 2 * count : count);
+        c.reserve(r.capacity());
+        v.reserve(r.capacity());
+        for (std::int64_t k = 0; k < count; ++k)
+        {
+            int i, j;
+            double value = 1.0;
+            if (!(in >> i >> j) || (!pattern && !(in >> value)))
+                throw std::runtime_error("Truncated Matrix Market file: " + path);
+            if (i < 1 || i > num_rows || j < 1 || j > num_cols)
+                throw std::runtime_error("Matrix Market entry (" + std::to_string(i) + ", " + std::to_string(j) + ") outside the " +
+                                         std::to_string(num_rows) + " x " + std::to_string(num_cols) + " matrix: " + path);
+            r.push_back(i - 1), c.push_back(j - 1), v.push_back(value);
+            if (symmetric && i != j)
+                r.push_back(j - 1), c.push_back(i - 1), v.push_back(mirror_sign * value);
+        }
+
+        const std::int64_t n = static_cast<std::int64_t>(r.size());
+        Kokkos::View<int *, ExecSpace> rows("sparse::coo_rows", n), cols("sparse::coo_cols", n);
+        Kokkos::View<double *, ExecSpace> vals("sparse::coo_vals", n);
+        auto rows_host = Kokkos::create_mirror_view(rows);
+        auto cols_host = Kokkos::create_mirror_view(cols);
+        auto vals_host = Kokkos::create_mirror_view(vals);
+        for (std::int64_t k = 0; k < n; ++k)
+        {
+            rows_host(k) = r[k];
+            cols_host(k) = c[k];
+            vals_host(k) = v[k];
+        }
+        Kokkos::deep_copy(rows, rows_host);
+        Kokkos::deep_copy(cols, cols_host);
+        Kokkos::deep_copy(vals, vals_host);
+        return from_coo(num_rows, num_cols, rows, cols, vals);
+    }
+}
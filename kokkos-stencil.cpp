@@ -0,0 +1,157 @@
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "kokkos-random.hpp"
+#include "kokkos-stencil.hpp"
+
+// Explicit heat equation with the 5-point and 9-point stencils: naive MDRangePolicy sweeps
+// against the tiled scratch-memory engine with 1, 2, 4 and 8 time steps per tile load
+// Usage: ./kokkos-stencil [--grid N] [--steps S] [--kokkos-num-threads=T] [--json file]
+//   --grid is the interior size of the N x N grid (default 2048), --steps the time steps per run (default 16)
+// Updates per second count interior points times time steps; the effective bandwidth assumes
+// the ideal 16 bytes per update (one read and one write of each cell per step).
+
+using Grid = Kokkos::View<double **>;
+
+const bench::Result *find_result(const bench::Runner &runner, const std::string &name)
+{
+    for (const auto &r : runner.results())
+        if (r.name == name)
+            return &r;
+    return nullptr; // filtered out
+}
+
+int parse_flag(int argc, char *argv[], const std::string &flag, int fallback)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == flag)
+            return std::atoi(argv[i + 1]);
+    return fallback;
+}
+
+// Random interior, hot top edge, cold elsewhere
+Grid initial_grid(int ny, int nx, std::uint64_t seed)
+{
+    Grid u("u", ny, nx);
+    random_fill::Filler<>(seed).uniform(u, 0.0, 1.0);
+    Kokkos::parallel_for("hot_edge", nx, KOKKOS_LAMBDA(int j) {
+        u(0, j) = 1.0;
+        u(ny - 1, j) = 0.0; });
+    Kokkos::parallel_for("cold_edges", ny, KOKKOS_LAMBDA(int i) {
+        if (i > 0)
+            u(i, 0) = u(i, nx - 1) = 0.0; });
+    return u;
+}
+
+// One host loop per step with the same arithmetic as the kernels
+Kokkos::View<double **, Kokkos::HostSpace> serial_reference(const Grid &u0, const stencil::Stencil &s, int steps)
+{
+    auto host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), u0);
+    Kokkos::View<double **, Kokkos::HostSpace> a("a", u0.extent(0), u0.extent(1)), b("b", u0.extent(0), u0.extent(1));
+    Kokkos::deep_copy(a, host);
+    Kokkos::deep_copy(b, host);
+    const int ny = static_cast<int>(a.extent(0)), nx = static_cast<int>(a.extent(1));
+    for (int step = 0; step < steps; ++step)
+    {
+        for (int i = 1; i < ny - 1; ++i)
+            for (int j = 1; j < nx - 1; ++j)
+                b(i, j) = s.apply(a, i, j);
+        std::swap(a, b);
+    }
+    return a;
+}
+
+double max_error(const Kokkos::View<double **, Kokkos::HostSpace> &ref, const Grid &u)
+{
+    auto h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), u);
+    double worst = 0.0;
+    for (std::size_t i = 0; i < ref.extent(0); ++i)
+        for (std::size_t j = 0; j < ref.extent(1); ++j)
+            worst = std::max(worst, std::abs(h(i, j) - ref(i, j)));
+    return worst;
+}
+
+bool report(const std::string &what, double error)
+{
+    bool ok = error <= 1e-12;
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << " (max error " << error << ")\n";
+    return ok;
+}
+
+// Tile sizes that do not divide the grid, and step counts that leave a partial time block
+bool verify(const std::string &name, const stencil::Stencil &s)
+{
+    const int ny = 203, nx = 317, steps = 7;
+    const Grid u0 = initial_grid(ny, nx, 7);
+    const auto ref = serial_reference(u0, s, steps);
+    Grid a("a", ny, nx), b("b", ny, nx);
+
+    bool ok = true;
+    Kokkos::deep_copy(a, u0);
+    ok &= report(name + " naive", max_error(ref, stencil::naive(a, b, s, steps)));
+    for (int block : {1, 2, 3, 4})
+    {
+        Kokkos::deep_copy(a, u0);
+        ok &= report(name + " tiled, " + std::to_string(block) + " step(s) per tile load", max_error(ref, stencil::Tiled<>::run(a, b, s, steps, block)));
+    }
+    return ok;
+}
+
+void benchmark(bench::Runner &runner, const std::string &name, const stencil::Stencil &s, int n, int steps)
+{
+    const Grid u0 = initial_grid(n + 2, n + 2, 11);
+    Grid a("a", n + 2, n + 2), b("b", n + 2, n + 2);
+    const double updates = double(n) * n * steps;
+    const double bytes = updates * 2 * sizeof(double);
+    const std::string suffix = " " + std::to_string(n) + "^2 x " + std::to_string(steps) + " steps";
+
+    std::vector<std::string> names;
+    names.push_back(name + " naive MDRange" + suffix);
+    runner.run(
+        names.back(), [&]()
+        { Kokkos::deep_copy(a, u0); bench::DoNotOptimize(stencil::naive(a, b, s, steps)); Kokkos::fence(); },
+        bytes);
+    for (int block : {1, 2, 4, 8})
+    {
+        names.push_back(name + " tiled T=" + std::to_string(block) + suffix);
+        runner.run(
+            names.back(), [&]()
+            { Kokkos::deep_copy(a, u0); bench::DoNotOptimize(stencil::Tiled<>::run(a, b, s, steps, block)); Kokkos::fence(); },
+            bytes);
+    }
+
+    for (const std::string &label : names)
+        if (const bench::Result *r = find_result(runner, label))
+            std::cout << "  " << label << ": " << updates / r->median_ns * 1e3 << " MLUP/s, "
+                      << bytes / r->median_ns << " GB/s effective\n";
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    const stencil::Stencil five = stencil::Stencil::five_point(0.2);
+    const stencil::Stencil nine = stencil::Stencil::nine_point(0.2);
+
+    std::cout << "\n=== Verification against a serial reference ===\n";
+    bool ok = verify("5-point", five);
+    ok &= verify("9-point", nine);
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const int n = parse_flag(argc, argv, "--grid", 2048);
+    const int steps = parse_flag(argc, argv, "--steps", 16);
+    benchmark(runner, "5-point", five, n, steps);
+    benchmark(runner, "9-point", nine, n, steps);
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstddef>
+#include <utility>
+
+// 2D 5-point / 9-point stencils (explicit heat equation / Jacobi) on View<double **>
+// The grid includes a one-cell boundary ring that keeps its values (Dirichlet); only the
+// interior is updated. Two buffers alternate between time steps (double buffering) and the
+// functions return the one holding the last step. Both buffers get the boundary of the first.
+// - naive: one MDRangePolicy kernel per time step
+// - Tiled<TY, TX>::run: one team per TY x TX tile, the tile and a halo of time_block cells
+//   are loaded into scratch memory once, time_block steps are done in scratch (two scratch
+//   buffers, the valid region shrinks by one cell per step), then the tile is written back
+namespace stencil
+{
+    // new = center * u + edge * (N + S + E + W) + corner * (NE + NW + SE + SW)
+    struct Stencil
+    {
+        double center;
+        double edge;
+        double corner;
+
+        // Explicit heat step with diffusion number alpha (stable for alpha <= 0.25)
+        static Stencil five_point(double alpha) { return {1.0 - 4.0 * alpha, alpha, 0.0}; }
+        // Isotropic 9-point Laplacian (4 edges + corners - 20 center) / 6
+        static Stencil nine_point(double alpha) { return {1.0 - 20.0 / 6.0 * alpha, 4.0 / 6.0 * alpha, 1.0 / 6.0 * alpha}; }
+
+        template <class Grid>
+        KOKKOS_INLINE_FUNCTION double apply(const Grid &u, int i, int j) const
+        {
+            double v = center * u(i, j) + edge * ((u(i - 1, j) + u(i + 1, j)) + (u(i, j - 1) + u(i, j + 1)));
+            if (corner != 0.0)
+                v += corner * ((u(i - 1, j - 1) + u(i - 1, j + 1)) + (u(i + 1, j - 1) + u(i + 1, j + 1)));
+            return v;
+        }
+    };
+
+    template <class View>
+    void copy_boundary(const View &from, const View &to)
+    {
+        using exec = typename View::execution_space;
+        const int ny = static_cast<int>(from.extent(0)), nx = static_cast<int>(from.extent(1));
+        Kokkos::parallel_for("stencil::boundary_rows", Kokkos::RangePolicy<exec>(0, nx), KOKKOS_LAMBDA(int j) {
+            to(0, j) = from(0, j);
+            to(ny - 1, j) = from(ny - 1, j); });
+        Kokkos::parallel_for("stencil::boundary_cols", Kokkos::RangePolicy<exec>(0, ny), KOKKOS_LAMBDA(int i) {
+            to(i, 0) = from(i, 0);
+            to(i, nx - 1) = from(i, nx - 1); });
+    }
+
+    template <class View>
+    View naive(View a, View b, const Stencil &s, int steps)
+    {
+        using exec = typename View::execution_space;
+        copy_boundary(a, b);
+        const int ny = static_cast<int>(a.extent(0)), nx = static_cast<int>(a.extent(1));
+        for (int step = 0; step < steps; ++step)
+        {
+            const View in = a, out = b;
+            Kokkos::parallel_for("stencil::naive", Kokkos::MDRangePolicy<exec, Kokkos::Rank<2>>({1, 1}, {ny - 1, nx - 1}), KOKKOS_LAMBDA(int i, int j) { out(i, j) = s.apply(in, i, j); });
+            std::swap(a, b);
+        }
+        return a;
+    }
+
+    template <int TY = 32, int TX = 32>
+    struct Tiled
+    {
+        template <class View>
+        static View run(View a, View b, const Stencil &s, int steps, int time_block = 1)
+        {
+            copy_boundary(a, b);
+            for (int done = 0; done < steps; done += time_block)
+            {
+                const int block = steps - done < time_block ? steps - done : time_block;
+                sweep(a, b, s, block);
+                std::swap(a, b);
+            }
+            return a;
+        }
+
+        // block time steps from in to out, one tile load per team
+        template <class View>
+        static void sweep(const View &in, const View &out, const Stencil &s, int block)
+        {
+            using exec = typename View::execution_space;
+            using policy = Kokkos::TeamPolicy<exec>;
+            using member = typename policy::member_type;
+            using scratch = Kokkos::View<double **, Kokkos::LayoutRight, typename exec::scratch_memory_space, Kokkos::MemoryUnmanaged>;
+
+            const int ny = static_cast<int>(in.extent(0)), nx = static_cast<int>(in.extent(1));
+            const int tiles_y = (ny - 2 + TY - 1) / TY, tiles_x = (nx - 2 + TX - 1) / TX;
+            const int sy = TY + 2 * block, sx = TX + 2 * block; // tile plus halo
+            const std::size_t bytes = 2 * scratch::shmem_size(sy, sx);
+
+            Kokkos::parallel_for(
+                "stencil::tiled", policy(tiles_y * tiles_x, Kokkos::AUTO).set_scratch_size(0, Kokkos::PerTeam(bytes)), KOKKOS_LAMBDA(const member &team) {
+                    // Global coordinates of scratch cell (0, 0)
+                    const int gi0 = 1 + (team.league_rank() / tiles_x) * TY - block;
+                    const int gj0 = 1 + (team.league_rank() % tiles_x) * TX - block;
+                    scratch t0(team.team_scratch(0), sy, sx);
+                    scratch t1(team.team_scratch(0), sy, sx);
+
+                    // Cells outside the grid only ever feed boundary cells, which are not updated
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, sy), [&](int r) {
+                        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, sx), [&](int c) {
+                            const int gi = gi0 + r, gj = gj0 + c;
+                            t0(r, c) = (gi >= 0 && gi < ny && gj >= 0 && gj < nx) ? in(gi, gj) : 0.0; }); });
+                    team.team_barrier();
+
+                    // Step k is valid on [k, size - k) of the scratch tile
+                    for (int k = 1; k <= block; ++k)
+                    {
+                        const scratch src = k % 2 ? t0 : t1;
+                        const scratch dst = k % 2 ? t1 : t0;
+                        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, k, sy - k), [&](int r) {
+                            Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, k, sx - k), [&](int c) {
+                                const int gi = gi0 + r, gj = gj0 + c;
+                                const bool interior = gi > 0 && gi < ny - 1 && gj > 0 && gj < nx - 1;
+                                dst(r, c) = interior ? s.apply(src, r, c) : src(r, c); }); });
+                        team.team_barrier();
+                    }
+
+                    const scratch result = block % 2 ? t1 : t0;
+                    const int rows = ny - 1 - (gi0 + block) < TY ? ny - 1 - (gi0 + block) : TY;
+                    const int cols = nx - 1 - (gj0 + block) < TX ? nx - 1 - (gj0 + block) : TX;
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, rows), [&](int r) {
+                        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, cols), [&](int c) {
+                            out(gi0 + block + r, gj0 + block + c) = result(block + r, block + c); }); }); });
+        }
+    };
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+// STREAM-style bandwidth suite on N x N matrices under MDRangePolicy
+// copy c = a, scale b = s * c, add c = a + b, triad a = b + s * c, for every combination of
+// - layout: LayoutRight / LayoutLeft
+// - index order: the policy's first index is the row (i, j) or the column (j, i)
+// - Iterate::Right / Iterate::Left of the MDRangePolicy (which policy index runs fastest)
+// - matrix size: from three matrices fitting in L1 to far beyond the last level cache
+// - thread count: 1, 2, 4, ... threads of the default execution space, through
+//   Kokkos::Experimental::partition_space (the rest of the threads stay idle)
+// Only the combinations whose fastest-running index is the contiguous one stream through memory;
+// the others stride by N doubles and fall off a cliff once a column of cache lines exceeds the cache.
+// Every run is timed by bench::Runner (--json holds the raw results), and Suite::write_csv writes
+// one row per run with the fields needed to plot a bandwidth roofline.
+namespace stream
+{
+    enum class Kernel
+    {
+        copy,
+        scale,
+        add,
+        triad
+    };
+
+    inline const char *name(Kernel k)
+    {
+        switch (k)
+        {
+        case Kernel::copy:
+            return "copy";
+        case Kernel::scale:
+            return "scale";
+        case Kernel::add:
+            return "add";
+        default:
+            return "triad";
+        }
+    }
+
+    // Bytes moved per element: copy and scale read one matrix, add and triad two, all write one
+    inline int bytes_per_element(Kernel k) { return k == Kernel::copy || k == Kernel::scale ? 16 : 24; }
+
+    struct Record
+    {
+        std::string kernel;
+        std::string layout;
+        std::string order; // "(i,j)" or "(j,i)"
+        std::string iterate;
+        int n;
+        int threads;
+        double bytes;
+        double median_ns;
+    };
+
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace>
+    class Suite
+    {
+        bench::Runner &runner_;
+        std::vector<Record> records_;
+
+        template <Kernel K, Kokkos::Iterate Iterate, bool Transposed, class Matrix>
+        static void kernel(const ExecSpace &space, const Matrix &a, const Matrix &b, const Matrix &c, int n)
+        {
+            // Rank<2, outer, inner>: both set to the same direction so the tiles follow it too
+            using policy = Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2, Iterate, Iterate>>;
+            const double s = 3.0;
+            Kokkos::parallel_for(std::string("stream::") + name(K), policy(space, {0, 0}, {n, n}), KOKKOS_LAMBDA(int p, int q) {
+                const int i = Transposed ? q : p;
+                const int j = Transposed ? p : q;
+                if constexpr (K == Kernel::copy)
+                    c(i, j) = a(i, j);
+                else if constexpr (K == Kernel::scale)
+                    b(i, j) = s * c(i, j);
+                else if constexpr (K == Kernel::add)
+                    c(i, j) = a(i, j) + b(i, j);
+                else
+                    a(i, j) = b(i, j) + s * c(i, j); });
+            space.fence();
+        }
+
+    public:
+        explicit Suite(bench::Runner &runner) : runner_(runner) {}
+
+        const std::vector<Record> &records() const { return this->records_; }
+
+        // 1, 2, 4, ... up to the concurrency of the execution space (always included)
+        static std::vector<int> thread_counts()
+        {
+            const int concurrency = ExecSpace().concurrency();
+            std::vector<int> counts;
+            for (int t = 1; t < concurrency; t *= 2)
+                counts.push_back(t);
+            counts.push_back(concurrency);
+            return counts;
+        }
+
+        // Every kernel, layout, index order and Iterate direction for one size and thread count
+        // Returns false, without running anything, when the backend cannot give a partition of
+        // exactly that many threads (partition_space of Threads returns copies of the whole space)
+        bool run(int n, int threads)
+        {
+            const int concurrency = ExecSpace().concurrency();
+            std::vector<ExecSpace> instances = {ExecSpace()};
+            if (threads < concurrency)
+                instances = Kokkos::Experimental::partition_space(ExecSpace(), std::vector<int>{threads, concurrency - threads});
+            const int actual = instances[0].concurrency();
+            if (actual != threads)
+            {
+                std::cout << "stream: asked for " << threads << " threads, the partition has " << actual << ", skipped\n";
+                return false;
+            }
+            run_layout<Kokkos::LayoutRight>("LayoutRight", instances[0], n, actual);
+            run_layout<Kokkos::LayoutLeft>("LayoutLeft", instances[0], n, actual);
+            return true;
+        }
+
+        void write_csv(const std::string &path) const
+        {
+            std::ofstream out(path);
+            out.precision(12);
+            out << "kernel,layout,order,iterate,n,threads,bytes,median_ns,gb_per_s\n";
+            for (const Record &r : records_)
+                out << r.kernel << "," << r.layout << "," << r.order << "," << r.iterate << "," << r.n << ","
+                    << r.threads << "," << r.bytes << "," << r.median_ns << "," << r.bytes / r.median_ns << "\n";
+        }
+
+    private:
+        template <class Layout>
+        void run_layout(const std::string &layout, const ExecSpace &space, int n, int threads)
+        {
+            using Matrix = Kokkos::View<double **, Layout, ExecSpace>;
+            Matrix a("stream_a", n, n), b("stream_b", n, n), c("stream_c", n, n);
+            Kokkos::deep_copy(a, 1.0);
+            Kokkos::deep_copy(b, 2.0);
+            Kokkos::deep_copy(c, 0.0);
+            run_orders<Kernel::copy>(layout, space, a, b, c, n, threads);
+            run_orders<Kernel::scale>(layout, space, a, b, c, n, threads);
+            run_orders<Kernel::add>(layout, space, a, b, c, n, threads);
+            run_orders<Kernel::triad>(layout, space, a, b, c, n, threads);
+        }
+
+        template <Kernel K, class Matrix>
+        void run_orders(const std::string &layout, const ExecSpace &space, const Matrix &a, const Matrix &b, const Matrix &c, int n, int threads)
+        {
+            constexpr Kokkos::Iterate right = Kokkos::Iterate::Right, left = Kokkos::Iterate::Left;
+            measure(layout, "(i,j)", "Iterate::Right", n, threads, K, [&]
+                    { kernel<K, right, false>(space, a, b, c, n); });
+            measure(layout, "(j,i)", "Iterate::Right", n, threads, K, [&]
+                    { kernel<K, right, true>(space, a, b, c, n); });
+            measure(layout, "(i,j)", "Iterate::Left", n, threads, K, [&]
+                    { kernel<K, left, false>(space, a, b, c, n); });
+            measure(layout, "(j,i)", "Iterate::Left", n, threads, K, [&]
+                    { kernel<K, left, true>(space, a, b, c, n); });
+        }
+
+        template <class F>
+        void measure(const std::string &layout, const std::string &order, const std::string &iterate, int n, int threads, Kernel k, F &&fn)
+        {
+            const std::string label = std::string(name(k)) + " " + layout + " " + order + " " + iterate + " " +
+                                      std::to_string(n) + "^2 t=" + std::to_string(threads);
+            const double bytes = double(n) * n * bytes_per_element(k);
+            const std::size_t before = runner_.results().size();
+            runner_.run(label, fn, bytes);
+            if (runner_.results().size() > before) // not filtered out
+                records_.push_back({name(k), layout, order, iterate, n, threads, bytes, runner_.results().back().median_ns});
+        }
+    };
+}
@@ -0,0 +1,146 @@
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "kokkos-reducers.hpp"
+#include "kokkos-task-graph.hpp"
+
+// Makespan of a batch of small, independent kernels (Parts 1, 2, 4 and 5 of
+// kokkos-parallel-patterns.cpp, --copies times) dispatched one after the other on the whole
+// execution space, against the task graph on 1, 2, 4, ... partitions
+// Usage: ./kokkos-task-graph [--copies N] [--kokkos-num-threads=T] [--json file]
+// Concurrency only appears with a multi-threaded backend (OpenMP or Threads).
+
+using Exec = Kokkos::DefaultExecutionSpace;
+using Policy = Kokkos::RangePolicy<Exec>;
+
+// Each copy adds four fill -> reduce chains; results[slot] receives each chain's value
+void build_batch(task_graph::Graph<Exec> &graph, int copies, std::vector<double> &results)
+{
+    results.assign(4 * copies, 0.0);
+    for (int c = 0; c < copies; ++c)
+    {
+        const std::string suffix = " #" + std::to_string(c);
+        double *out = results.data() + 4 * c;
+
+        // Part 1
+        Kokkos::View<double *> vector("vector_reduce", 1000);
+        int fill = graph.add("fill vector_reduce" + suffix, [=](const Exec &space)
+                             { Kokkos::parallel_for("fill vector_reduce", Policy(space, 0, 1000), KOKKOS_LAMBDA(int i) { vector(i) = ((i + c) % 97) / 97.0; }); });
+        graph.add("reduce vector_reduce" + suffix, [=](const Exec &space)
+                  {
+            reducers::StatsValue stats;
+            Kokkos::parallel_reduce("reduce vector_reduce", Policy(space, 0, 1000), KOKKOS_LAMBDA(int i, reducers::StatsValue &update) { update.add(vector(i), 0.5); }, reducers::Stats<>(stats));
+            out[0] = stats.sum + stats.max - stats.min + stats.count_above; },
+                  {fill});
+
+        // Part 2
+        Kokkos::View<double **> A("A", 100, 100), B("B", 100, 100), C("C", 100, 100);
+        fill = graph.add("fill_A_B-find_C" + suffix, [=](const Exec &space)
+                         { Kokkos::parallel_for("fill_A_B-find_C", Kokkos::MDRangePolicy<Exec, Kokkos::Rank<2>>(space, {0, 0}, {100, 100}), KOKKOS_LAMBDA(int i, int j) {
+                A(i,j) = i + j + c;
+                B(i,j) = i * j;
+                C(i,j) = A(i,j) + B(i,j); }); });
+        graph.add("Frobenius_C" + suffix, [=](const Exec &space)
+                  {
+            double sum = 0;
+            Kokkos::parallel_reduce("Frobenius_C", Policy(space, 0, 100 * 100), KOKKOS_LAMBDA(int id, double &tempSum) {
+                int i = id / 100;
+                int j = id % 100;
+                tempSum += C(i,j) * C(i,j); }, sum);
+            out[1] = std::sqrt(sum); },
+                  {fill});
+
+        // Part 4
+        Kokkos::View<double *> a("a", 10000), b("b", 10000);
+        fill = graph.add("fill_a_b" + suffix, [=](const Exec &space)
+                         { Kokkos::parallel_for("fill_a_b", Policy(space, 0, 10000), KOKKOS_LAMBDA(int i) {
+                a(i) = i + c;
+                b(i) = 2*i; }); });
+        graph.add("dot_a_b" + suffix, [=](const Exec &space)
+                  {
+            double dot = 0;
+            Kokkos::parallel_reduce("dot_a_b", Policy(space, 0, 10000), KOKKOS_LAMBDA(int i, double &tempDot) { tempDot += a(i) * b(i); }, dot);
+            out[2] = dot; },
+                  {fill});
+
+        // Part 5
+        Kokkos::View<double *> extrema("extrema", 100);
+        fill = graph.add("fill extrema" + suffix, [=](const Exec &space)
+                         { Kokkos::parallel_for("fill extrema", Policy(space, 0, 100), KOKKOS_LAMBDA(int i) { extrema(i) = ((i * 37 + c) % 100) * 1.0; }); });
+        graph.add("finding_extrema" + suffix, [=](const Exec &space)
+                  {
+            Kokkos::MinMaxLoc<double, int>::value_type result;
+            Kokkos::parallel_reduce("finding_extrema", Policy(space, 0, 100), KOKKOS_LAMBDA(int i, Kokkos::MinMaxLoc<double, int>::value_type &update) {
+                if(extrema(i) < update.min_val){
+                    update.min_val = extrema(i);
+                    update.min_loc = i;
+                }
+                if(extrema(i) > update.max_val){
+                    update.max_val = extrema(i);
+                    update.max_loc = i;
+                } }, Kokkos::MinMaxLoc<double, int>(result));
+            out[3] = result.max_loc * 1000.0 + result.min_loc; },
+                  {fill});
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    clocks::init();
+    const int concurrency = Exec().concurrency();
+    std::cout << "Execution Space: " << typeid(Exec).name() << ", concurrency " << concurrency << "\n";
+
+    int copies = 8;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--copies")
+            copies = std::atoi(argv[i + 1]);
+
+    task_graph::Graph<Exec> graph;
+    std::vector<double> results;
+    build_batch(graph, copies, results);
+
+    std::vector<int> partitions = {1};
+    for (int p = 2; p <= concurrency; p *= 2)
+        partitions.push_back(p);
+
+    // Every schedule must produce the sequential results; each partition count groups the
+    // floating-point reductions differently, so only up to rounding
+    graph.run_sequential();
+    const std::vector<double> expected = results;
+    bool ok = true;
+    std::vector<int> measured; // partition counts the backend really provides
+    for (int p : partitions)
+    {
+        std::fill(results.begin(), results.end(), 0.0);
+        task_graph::Report report = graph.run(p);
+        bool same = true;
+        for (std::size_t i = 0; i < results.size(); ++i)
+            same &= std::abs(results[i] - expected[i]) <= 1e-12 * std::max(1.0, std::abs(expected[i]));
+        if (report.partitions != p)
+            std::cout << "backend cannot partition, " << p << " partition(s) ran on " << report.partitions << "\n";
+        else
+            measured.push_back(p);
+        std::cout << (same ? "[PASS] " : "[FAIL] ") << p << " partition(s) reproduce the sequential results\n";
+        ok &= same;
+        if (p == partitions.back())
+            report.print(std::cout);
+    }
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    const std::string batch = " (" + std::to_string(graph.size()) + " kernels)";
+    runner.run("sequential dispatch" + batch, [&]()
+               { graph.run_sequential(); });
+    for (int p : measured)
+        runner.run("task graph " + std::to_string(p) + " partition(s)" + batch, [&]()
+                   { graph.run(p); });
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
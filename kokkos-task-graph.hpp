@@ -0,0 +1,201 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tsc-clock.hpp"
+
+// Task graph of labeled kernels on partitioned execution space instances
+// Independent kernels of a batch usually run back to back on the whole execution space, with
+// a fence between them; for small kernels most cores sit idle. Here the host execution space is
+// split with Kokkos::Experimental::partition_space and each instance is driven by its own host
+// thread (host backends run a kernel in the thread that launches it), so kernels with no
+// dependency between them run at the same time. A task only waits for the tasks it depends on.
+//
+//   task_graph::Graph<> graph;
+//   int fill = graph.add("fill", [=](const auto &space) { Kokkos::parallel_for(Kokkos::RangePolicy<Exec>(space, 0, n), ...); });
+//   graph.add("reduce", [=](const auto &space) { ... }, {fill});
+//   task_graph::Report report = graph.run(4); // 4 partitions
+namespace task_graph
+{
+    struct TaskTime
+    {
+        std::string label;
+        int partition;
+        double start_ns;
+        double end_ns;
+    };
+
+    struct Report
+    {
+        double makespan_ns = 0;
+        int partitions = 1; // instances actually used, see Graph::run
+        std::vector<TaskTime> tasks;
+
+        void print(std::ostream &os) const
+        {
+            char line[256];
+            std::snprintf(line, sizeof(line), "makespan %.1f us, %zu tasks\n", makespan_ns / 1e3, tasks.size());
+            os << line;
+            std::snprintf(line, sizeof(line), "  %-32s %9s %12s %12s\n", "task", "partition", "start(us)", "end(us)");
+            os << line;
+            for (const auto &t : tasks)
+            {
+                std::snprintf(line, sizeof(line), "  %-32s %9d %12.1f %12.1f\n", t.label.c_str(), t.partition, t.start_ns / 1e3, t.end_ns / 1e3);
+                os << line;
+            }
+        }
+    };
+
+    template <class ExecSpace = Kokkos::DefaultExecutionSpace>
+    class Graph
+    {
+    public:
+        using task_fn = std::function<void(const ExecSpace &)>;
+
+    private:
+        struct Task
+        {
+            std::string label;
+            task_fn fn;
+            std::vector<int> deps;
+            std::vector<int> dependents;
+        };
+
+        std::vector<Task> tasks_;
+
+    public:
+        // deps must name tasks added earlier, which keeps the graph acyclic
+        int add(const std::string &label, task_fn fn, const std::vector<int> &deps = {})
+        {
+            const int id = static_cast<int>(tasks_.size());
+            for (int d : deps)
+                if (d < 0 || d >= id)
+                    throw std::invalid_argument("task_graph: dependency of " + label + " is not an earlier task");
+            tasks_.push_back({label, std::move(fn), deps, {}});
+            for (int d : deps)
+                tasks_[d].dependents.push_back(id);
+            return id;
+        }
+
+        std::size_t size() const { return tasks_.size(); }
+
+        // Reference: every task in insertion order on the whole execution space, fenced after each
+        Report run_sequential() const
+        {
+            Report report;
+            ExecSpace space;
+            const std::int64_t start = clocks::now_ticks();
+            for (const Task &t : tasks_)
+            {
+                const double begin = elapsed_ns(start);
+                t.fn(space);
+                space.fence();
+                report.tasks.push_back({t.label, 0, begin, elapsed_ns(start)});
+            }
+            report.makespan_ns = elapsed_ns(start);
+            return report;
+        }
+
+        // Tasks run on `partitions` equal instances as soon as their dependencies are done
+        // Backends that cannot partition (Threads) return copies of the whole instance, and
+        // launching from several host threads into one instance is not allowed: those run on a
+        // single partition, Report::partitions says how many were used
+        Report run(int partitions) const
+        {
+            std::vector<int> weights(std::max(partitions, 1), 1);
+            std::vector<ExecSpace> instances = Kokkos::Experimental::partition_space(ExecSpace(), weights);
+            const int whole = ExecSpace().concurrency();
+            for (const ExecSpace &instance : instances)
+                if (instances.size() > 1 && whole > 1 && instance.concurrency() >= whole)
+                {
+                    instances.assign(1, ExecSpace());
+                    break;
+                }
+            partitions = static_cast<int>(instances.size());
+
+            std::vector<int> waiting(tasks_.size());
+            std::deque<int> ready;
+            for (std::size_t i = 0; i < tasks_.size(); ++i)
+                if ((waiting[i] = static_cast<int>(tasks_[i].deps.size())) == 0)
+                    ready.push_back(static_cast<int>(i));
+
+            Report report;
+            report.partitions = partitions;
+            report.tasks.resize(tasks_.size());
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::size_t finished = 0;
+            std::exception_ptr error;
+            const std::int64_t start = clocks::now_ticks();
+
+            auto worker = [&](int p)
+            {
+                const ExecSpace &space = instances[p];
+                std::unique_lock<std::mutex> lock(mutex);
+                while (true)
+                {
+                    cv.wait(lock, [&]
+                            { return !ready.empty() || finished == tasks_.size() || error; });
+                    if (ready.empty())
+                        return;
+                    const int id = ready.front();
+                    ready.pop_front();
+                    lock.unlock();
+
+                    const double begin = elapsed_ns(start);
+                    try
+                    {
+                        tasks_[id].fn(space);
+                        space.fence(); // this instance only, the other partitions keep running
+                    }
+                    catch (...)
+                    {
+                        lock.lock();
+                        error = std::current_exception();
+                        ready.clear();
+                        cv.notify_all();
+                        return;
+                    }
+                    const double end = elapsed_ns(start);
+
+                    lock.lock();
+                    report.tasks[id] = {tasks_[id].label, p, begin, end};
+                    ++finished;
+                    for (int d : tasks_[id].dependents)
+                        if (--waiting[d] == 0)
+                            ready.push_back(d);
+                    cv.notify_all();
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (int p = 0; p < partitions; ++p)
+                threads.emplace_back(worker, p);
+            for (auto &t : threads)
+                t.join();
+            report.makespan_ns = elapsed_ns(start);
+            if (error)
+                std::rethrow_exception(error);
+            return report;
+        }
+
+    private:
+        static double elapsed_ns(std::int64_t start)
+        {
+            return clocks::to_ns(static_cast<double>(clocks::now_ticks() - start));
+        }
+    };
+}
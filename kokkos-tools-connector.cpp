@@ -0,0 +1,71 @@
+#include <cstdint>
+
+#include "kokkos-tools-connector.hpp"
+
+// Entry points looked up by Kokkos when this library is listed in KOKKOS_TOOLS_LIBS
+// Build: g++ -std=c++20 -O2 -shared -fPIC kokkos-tools-connector.cpp -o libkokkos-tools-connector.so
+
+extern "C" void kokkosp_init_library(const int load_seq, const uint64_t interface_version,
+                                     const uint32_t device_count, Kokkos_Profiling_KokkosPDeviceInfo *device_info)
+{
+    kokkos_connector::init_library(load_seq, interface_version, device_count, device_info);
+}
+
+extern "C" void kokkosp_finalize_library()
+{
+    kokkos_connector::finalize_library();
+}
+
+extern "C" void kokkosp_begin_parallel_for(const char *name, const uint32_t device_id, uint64_t *kernel_id)
+{
+    kokkos_connector::begin_parallel_for(name, device_id, kernel_id);
+}
+
+extern "C" void kokkosp_end_parallel_for(const uint64_t kernel_id)
+{
+    kokkos_connector::end_kernel(kernel_id);
+}
+
+extern "C" void kokkosp_begin_parallel_reduce(const char *name, const uint32_t device_id, uint64_t *kernel_id)
+{
+    kokkos_connector::begin_parallel_reduce(name, device_id, kernel_id);
+}
+
+extern "C" void kokkosp_end_parallel_reduce(const uint64_t kernel_id)
+{
+    kokkos_connector::end_kernel(kernel_id);
+}
+
+extern "C" void kokkosp_begin_parallel_scan(const char *name, const uint32_t device_id, uint64_t *kernel_id)
+{
+    kokkos_connector::begin_parallel_scan(name, device_id, kernel_id);
+}
+
+extern "C" void kokkosp_end_parallel_scan(const uint64_t kernel_id)
+{
+    kokkos_connector::end_kernel(kernel_id);
+}
+
+extern "C" void kokkosp_allocate_data(const Kokkos_Profiling_SpaceHandle space, const char *label,
+                                      const void *const ptr, const uint64_t size)
+{
+    kokkos_connector::allocate_data(space, label, ptr, size);
+}
+
+extern "C" void kokkosp_deallocate_data(const Kokkos_Profiling_SpaceHandle space, const char *label,
+                                        const void *const ptr, const uint64_t size)
+{
+    kokkos_connector::deallocate_data(space, label, ptr, size);
+}
+
+extern "C" void kokkosp_begin_deep_copy(Kokkos_Profiling_SpaceHandle dst_handle, const char *dst_name, const void *dst_ptr,
+                                        Kokkos_Profiling_SpaceHandle src_handle, const char *src_name, const void *src_ptr,
+                                        uint64_t size)
+{
+    kokkos_connector::begin_deep_copy(dst_handle, dst_name, dst_ptr, src_handle, src_name, src_ptr, size);
+}
+
+extern "C" void kokkosp_end_deep_copy()
+{
+    kokkos_connector::end_deep_copy();
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "tsc-clock.hpp"
+
+// Kokkos Tools profiling connector
+// Aggregates the labeled kernels (parallel_for/reduce/scan), deep copies and allocations:
+// - per kernel label: calls, total/avg/min/max time
+// - per deep copy (destination <- source space): calls, bytes, time
+// - per memory space: allocations, current and peak bytes
+// The report is printed when Kokkos finalizes.
+//
+// Two ways to use it (Serial, OpenMP and Threads backends, no GPU needed):
+// - as a tool library: build kokkos-tools-connector.cpp as a shared library and run with
+//   KOKKOS_TOOLS_LIBS=./libkokkos-tools-connector.so ./kokkos-parallel-patterns
+// - in process: include this header after Kokkos_Core.hpp and call
+//   kokkos_connector::register_callbacks() right after Kokkos::initialize / ScopeGuard
+
+#if __has_include(<impl/Kokkos_Profiling_C_Interface.h>)
+#include <impl/Kokkos_Profiling_C_Interface.h>
+#else
+// Same layout as Kokkos' C interface, so the tool library builds without Kokkos installed
+struct Kokkos_Profiling_SpaceHandle
+{
+    char name[64];
+};
+
+struct Kokkos_Profiling_KokkosPDeviceInfo
+{
+    size_t deviceID;
+};
+#endif
+
+namespace kokkos_connector
+{
+    enum class Kind
+    {
+        parallel_for,
+        parallel_reduce,
+        parallel_scan
+    };
+
+    inline const char *kind_name(Kind k)
+    {
+        switch (k)
+        {
+        case Kind::parallel_for:
+            return "parallel_for";
+        case Kind::parallel_reduce:
+            return "parallel_reduce";
+        default:
+            return "parallel_scan";
+        }
+    }
+
+    struct KernelStats
+    {
+        std::uint64_t calls = 0;
+        double total_ns = 0, min_ns = 1e300, max_ns = 0;
+    };
+
+    struct CopyStats
+    {
+        std::uint64_t calls = 0;
+        std::uint64_t bytes = 0;
+        double total_ns = 0;
+    };
+
+    struct SpaceStats
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t current_bytes = 0;
+        std::uint64_t peak_bytes = 0;
+    };
+
+    class Connector
+    {
+    private:
+        struct Open
+        {
+            Kind kind;
+            std::string label;
+            std::int64_t start;
+        };
+
+        std::mutex mutex_;
+        std::uint64_t next_id_ = 0;
+        std::unordered_map<std::uint64_t, Open> open_;
+        std::map<std::pair<std::string, Kind>, KernelStats> kernels_;
+        std::map<std::string, CopyStats> copies_;
+        std::map<std::string, SpaceStats> spaces_;
+        std::string copy_key_;
+        std::uint64_t copy_bytes_ = 0;
+        std::int64_t copy_start_ = 0;
+        bool finalized_ = false;
+
+    public:
+        static Connector &instance()
+        {
+            static Connector c;
+            return c;
+        }
+
+        void begin_kernel(Kind kind, const char *name, std::uint64_t *id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            *id = next_id_++;
+            open_[*id] = {kind, name ? name : "(unlabeled)", clocks::now_ticks()};
+        }
+
+        void end_kernel(std::uint64_t id)
+        {
+            std::int64_t end = clocks::now_ticks();
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = open_.find(id);
+            if (it == open_.end())
+                return;
+            double ns = clocks::to_ns(static_cast<double>(end - it->second.start));
+            KernelStats &s = kernels_[{it->second.label, it->second.kind}];
+            s.calls += 1;
+            s.total_ns += ns;
+            s.min_ns = std::min(s.min_ns, ns);
+            s.max_ns = std::max(s.max_ns, ns);
+            open_.erase(it);
+        }
+
+        void allocate(const char *space, std::uint64_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            SpaceStats &s = spaces_[space];
+            s.allocations += 1;
+            s.current_bytes += bytes;
+            s.peak_bytes = std::max(s.peak_bytes, s.current_bytes);
+        }
+
+        void deallocate(const char *space, std::uint64_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            SpaceStats &s = spaces_[space];
+            s.current_bytes -= std::min(s.current_bytes, bytes);
+        }
+
+        // Kokkos does not nest deep copies, a single pending copy is enough
+        void begin_deep_copy(const char *dst_space, const char *src_space, std::uint64_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            copy_key_ = std::string(dst_space) + " <- " + src_space;
+            copy_bytes_ = bytes;
+            copy_start_ = clocks::now_ticks();
+        }
+
+        void end_deep_copy()
+        {
+            std::int64_t end = clocks::now_ticks();
+            std::lock_guard<std::mutex> lock(mutex_);
+            CopyStats &s = copies_[copy_key_];
+            s.calls += 1;
+            s.bytes += copy_bytes_;
+            s.total_ns += clocks::to_ns(static_cast<double>(end - copy_start_));
+        }
+
+        void report(std::ostream &os)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (finalized_)
+                return;
+            finalized_ = true;
+
+            char line[256];
+            os << "\n=== Kokkos kernels (clock: " << clocks::source_name() << ") ===\n";
+            std::snprintf(line, sizeof(line), "%-32s %-16s %8s %14s %12s %12s %12s\n",
+                          "label", "type", "calls", "total(us)", "avg(us)", "min(us)", "max(us)");
+            os << line;
+            for (const auto &[key, s] : kernels_)
+            {
+                std::snprintf(line, sizeof(line), "%-32s %-16s %8llu %14.2f %12.2f %12.2f %12.2f\n",
+                              key.first.c_str(), kind_name(key.second), static_cast<unsigned long long>(s.calls),
+                              s.total_ns / 1e3, s.total_ns / 1e3 / static_cast<double>(s.calls), s.min_ns / 1e3, s.max_ns / 1e3);
+                os << line;
+            }
+
+            os << "\n=== Deep copies ===\n";
+            std::snprintf(line, sizeof(line), "%-32s %8s %16s %14s %10s\n", "dst <- src", "calls", "bytes", "total(us)", "GB/s");
+            os << line;
+            for (const auto &[key, s] : copies_)
+            {
+                std::snprintf(line, sizeof(line), "%-32s %8llu %16llu %14.2f %10.2f\n", key.c_str(),
+                              static_cast<unsigned long long>(s.calls), static_cast<unsigned long long>(s.bytes),
+                              s.total_ns / 1e3, s.total_ns > 0 ? static_cast<double>(s.bytes) / s.total_ns : 0.0);
+                os << line;
+            }
+
+            os << "\n=== Memory spaces ===\n";
+            std::snprintf(line, sizeof(line), "%-32s %12s %16s %16s\n", "space", "allocations", "peak bytes", "leaked bytes");
+            os << line;
+            for (const auto &[space, s] : spaces_)
+            {
+                std::snprintf(line, sizeof(line), "%-32s %12llu %16llu %16llu\n", space.c_str(),
+                              static_cast<unsigned long long>(s.allocations), static_cast<unsigned long long>(s.peak_bytes),
+                              static_cast<unsigned long long>(s.current_bytes));
+                os << line;
+            }
+        }
+    };
+
+    // Callbacks with the Kokkos Tools signatures
+    inline void init_library(const int, const std::uint64_t, const std::uint32_t, Kokkos_Profiling_KokkosPDeviceInfo *)
+    {
+        clocks::init();
+        Connector::instance();
+    }
+    inline void finalize_library() { Connector::instance().report(std::cout); }
+
+    inline void begin_parallel_for(const char *name, const std::uint32_t, std::uint64_t *id) { Connector::instance().begin_kernel(Kind::parallel_for, name, id); }
+    inline void begin_parallel_reduce(const char *name, const std::uint32_t, std::uint64_t *id) { Connector::instance().begin_kernel(Kind::parallel_reduce, name, id); }
+    inline void begin_parallel_scan(const char *name, const std::uint32_t, std::uint64_t *id) { Connector::instance().begin_kernel(Kind::parallel_scan, name, id); }
+    inline void end_kernel(const std::uint64_t id) { Connector::instance().end_kernel(id); }
+
+    inline void allocate_data(const Kokkos_Profiling_SpaceHandle space, const char *, const void *const, const std::uint64_t size)
+    {
+        Connector::instance().allocate(space.name, size);
+    }
+    inline void deallocate_data(const Kokkos_Profiling_SpaceHandle space, const char *, const void *const, const std::uint64_t size)
+    {
+        Connector::instance().deallocate(space.name, size);
+    }
+
+    inline void begin_deep_copy(Kokkos_Profiling_SpaceHandle dst_space, const char *, const void *,
+                                Kokkos_Profiling_SpaceHandle src_space, const char *, const void *, std::uint64_t size)
+    {
+        Connector::instance().begin_deep_copy(dst_space.name, src_space.name, size);
+    }
+    inline void end_deep_copy() { Connector::instance().end_deep_copy(); }
+
+#ifdef KOKKOS_VERSION
+    // In-process registration through the Kokkos Tools callback API
+    inline void register_callbacks()
+    {
+        namespace kte = Kokkos::Tools::Experimental;
+        clocks::init(); // not in the first begin_kernel, with mutex_ held
+        Connector::instance();
+        kte::set_finalize_callback(finalize_library);
+        kte::set_begin_parallel_for_callback(begin_parallel_for);
+        kte::set_end_parallel_for_callback(end_kernel);
+        kte::set_begin_parallel_reduce_callback(begin_parallel_reduce);
+        kte::set_end_parallel_reduce_callback(end_kernel);
+        kte::set_begin_parallel_scan_callback(begin_parallel_scan);
+        kte::set_end_parallel_scan_callback(end_kernel);
+        kte::set_allocate_data_callback(allocate_data);
+        kte::set_deallocate_data_callback(deallocate_data);
+        kte::set_begin_deep_copy_callback(begin_deep_copy);
+        kte::set_end_deep_copy_callback(end_deep_copy);
+    }
+#endif
+}
@@ -0,0 +1,185 @@
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "benchmark.hpp"
+#include "kokkos-transpose.hpp"
+
+// GB/s of relayout::convert / relayout::transpose against deep_copy across layouts and an
+// element-wise parallel_for, on square, non-square / non-tile-multiple and rank 3 Views
+// Usage: ./kokkos-transpose [--size N] [--kokkos-num-threads=T] [--json file]
+//   --size is the edge of the large square case (default 4096); bytes count one read and one write
+
+using Left2 = Kokkos::View<double **, Kokkos::LayoutLeft>;
+using Right2 = Kokkos::View<double **, Kokkos::LayoutRight>;
+using Left3 = Kokkos::View<double ***, Kokkos::LayoutLeft>;
+using Right3 = Kokkos::View<double ***, Kokkos::LayoutRight>;
+
+bool report(const std::string &what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+// Unique value per element, so any misplaced element is caught
+double value(std::int64_t i, std::int64_t j, std::int64_t k = 0) { return double(i) * 1e6 + double(j) * 1e3 + double(k); }
+
+template <class View>
+bool holds_values(const View &v, bool transposed = false)
+{
+    auto h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v);
+    for (std::size_t i = 0; i < h.extent(0); ++i)
+        for (std::size_t j = 0; j < h.extent(1); ++j)
+            if constexpr (View::rank == 3)
+            {
+                for (std::size_t k = 0; k < h.extent(2); ++k)
+                    if (h(i, j, k) != value(i, j, k))
+                        return false;
+            }
+            else if (h(i, j) != (transposed ? value(j, i) : value(i, j)))
+                return false;
+    return true;
+}
+
+template <class View>
+void fill_values(const View &v)
+{
+    if constexpr (View::rank == 3)
+        Kokkos::parallel_for("fill", Kokkos::MDRangePolicy<Kokkos::Rank<3>>({0, 0, 0}, {v.extent(0), v.extent(1), v.extent(2)}), KOKKOS_LAMBDA(std::int64_t i, std::int64_t j, std::int64_t k) { v(i, j, k) = double(i) * 1e6 + double(j) * 1e3 + double(k); });
+    else
+        Kokkos::parallel_for("fill", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {v.extent(0), v.extent(1)}), KOKKOS_LAMBDA(std::int64_t i, std::int64_t j) { v(i, j) = double(i) * 1e6 + double(j) * 1e3; });
+}
+
+// One thread per destination element in the destination's memory order: writes are contiguous,
+// reads stride across the source
+template <class Dst, class Src>
+void naive_convert(const Dst &dst, const Src &src)
+{
+    constexpr bool right = std::is_same_v<typename Dst::array_layout, Kokkos::LayoutRight>;
+    const std::int64_t n0 = dst.extent(0), n1 = dst.extent(1), n2 = Dst::rank == 3 ? dst.extent(2) : 1;
+    Kokkos::parallel_for("naive_convert", n0 * n1 * n2, KOKKOS_LAMBDA(std::int64_t id) {
+        if constexpr (Dst::rank == 3)
+        {
+            const std::int64_t i = right ? id / (n1 * n2) : id % n0;
+            const std::int64_t j = right ? id / n2 % n1 : id / n0 % n1;
+            const std::int64_t k = right ? id % n2 : id / (n0 * n1);
+            dst(i, j, k) = src(i, j, k);
+        }
+        else
+        {
+            const std::int64_t i = right ? id / n1 : id % n0;
+            const std::int64_t j = right ? id % n1 : id / n0;
+            dst(i, j) = src(i, j);
+        } });
+}
+
+template <class View>
+void naive_transpose(const View &dst, const View &src)
+{
+    constexpr bool right = std::is_same_v<typename View::array_layout, Kokkos::LayoutRight>;
+    const std::int64_t n0 = dst.extent(0), n1 = dst.extent(1);
+    Kokkos::parallel_for("naive_transpose", n0 * n1, KOKKOS_LAMBDA(std::int64_t id) {
+        const std::int64_t i = right ? id / n1 : id % n0;
+        const std::int64_t j = right ? id % n1 : id / n0;
+        dst(i, j) = src(j, i); });
+}
+
+// Conversion in both directions: deep_copy, naive and tiled
+template <class A, class B>
+bool run_convert(bench::Runner &runner, const std::string &shape, const A &a, const B &b)
+{
+    const double bytes = 2.0 * a.span() * sizeof(double);
+    fill_values(a);
+    bool ok = true;
+    relayout::convert(b, a);
+    ok &= report("convert " + shape + " " + a.label() + " -> " + b.label(), holds_values(b));
+    Kokkos::deep_copy(a, 0.0);
+    relayout::convert(a, b);
+    ok &= report("convert " + shape + " " + b.label() + " -> " + a.label(), holds_values(a));
+
+    runner.run(
+        "deep_copy " + shape + " " + a.label() + " -> " + b.label(), [&]()
+        { Kokkos::deep_copy(b, a); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "naive " + shape + " " + a.label() + " -> " + b.label(), [&]()
+        { naive_convert(b, a); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "tiled " + shape + " " + a.label() + " -> " + b.label(), [&]()
+        { relayout::convert(b, a); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "deep_copy " + shape + " " + b.label() + " -> " + a.label(), [&]()
+        { Kokkos::deep_copy(a, b); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "naive " + shape + " " + b.label() + " -> " + a.label(), [&]()
+        { naive_convert(a, b); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "tiled " + shape + " " + b.label() + " -> " + a.label(), [&]()
+        { relayout::convert(a, b); Kokkos::fence(); },
+        bytes);
+    return ok;
+}
+
+template <class View>
+bool run_transpose(bench::Runner &runner, const std::string &shape, std::int64_t rows, std::int64_t cols)
+{
+    View a(std::string("transpose ") + (std::is_same_v<typename View::array_layout, Kokkos::LayoutRight> ? "LayoutRight" : "LayoutLeft"), rows, cols);
+    View at("at", cols, rows);
+    const double bytes = 2.0 * a.span() * sizeof(double);
+    fill_values(a);
+    relayout::transpose(at, a);
+    bool ok = report(a.label() + " " + shape, holds_values(at, true));
+
+    runner.run(
+        "naive " + a.label() + " " + shape, [&]()
+        { naive_transpose(at, a); Kokkos::fence(); },
+        bytes);
+    runner.run(
+        "tiled " + a.label() + " " + shape, [&]()
+        { relayout::transpose(at, a); Kokkos::fence(); },
+        bytes);
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    int n = 4096;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--size")
+            n = std::atoi(argv[i + 1]);
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    bool ok = true;
+    {
+        Left2 left("LayoutLeft", n, n);
+        Right2 right("LayoutRight", n, n);
+        ok &= run_convert(runner, std::to_string(n) + "^2", left, right);
+    }
+    {
+        // Neither extent a multiple of the tile, and far from square
+        Left2 left("LayoutLeft", 3001, 4999);
+        Right2 right("LayoutRight", 3001, 4999);
+        ok &= run_convert(runner, "3001x4999", left, right);
+    }
+    {
+        Left3 left("LayoutLeft", 200, 300, 257);
+        Right3 right("LayoutRight", 200, 300, 257);
+        ok &= run_convert(runner, "200x300x257", left, right);
+    }
+    ok &= run_transpose<Right2>(runner, "3001x4999", 3001, 4999);
+    ok &= run_transpose<Left2>(runner, "3001x4999", 3001, 4999);
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
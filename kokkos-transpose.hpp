@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Layout conversion (LayoutLeft <-> LayoutRight) and transpose of rank 2 and rank 3 Views
+// Copying between layouts element by element always walks one side with a stride of a whole
+// row or column: every access touches a new cache line, and on large Views a new page.
+// Here one team handles a T x T tile of the two axes whose order differs between the Views:
+// the tile is read into scratch memory along the source's contiguous axis and written out
+// along the destination's contiguous axis, so both sides move whole cache lines.
+// Tiles are visited in column groups of `group` tile rows, so consecutive teams share the pages
+// of the same rows instead of sweeping a whole row of tiles (TLB reach).
+// Extents need not be multiples of T; rank 3 Views are converted plane by plane along axis 1.
+//
+//   relayout::convert(right, left);   // right(i, j) = left(i, j), any extents
+//   relayout::transpose(at, a);       // at(j, i) = a(i, j), rank 2, any layouts
+namespace relayout
+{
+    template <class Layout>
+    constexpr bool is_layout_right = std::is_same_v<Layout, Kokkos::LayoutRight>;
+
+    // dst(a, b) = src(a, b), or dst(b, a) = src(a, b) when Swap; for rank 3 a and b are axes 0 and 2
+    template <bool Swap, int T = 32, int Group = 8, class Dst, class Src>
+    void tiled(const char *label, const Dst &dst, const Src &src)
+    {
+        static_assert(Dst::rank == Src::rank && (Dst::rank == 2 || Dst::rank == 3), "relayout: rank 2 or 3 Views of equal rank");
+        static_assert(!Swap || Dst::rank == 2, "relayout: transpose is rank 2 only");
+        using exec = typename Dst::execution_space;
+        using value_type = typename Dst::non_const_value_type;
+        using policy = Kokkos::TeamPolicy<exec>;
+        using member = typename policy::member_type;
+        using scratch = Kokkos::View<value_type **, Kokkos::LayoutRight, typename exec::scratch_memory_space, Kokkos::MemoryUnmanaged>;
+
+        constexpr int last = Src::rank - 1;
+        const int na = static_cast<int>(src.extent(0)), nb = static_cast<int>(src.extent(last));
+        const int planes = Src::rank == 3 ? static_cast<int>(src.extent(1)) : 1;
+        // Which of a / b is contiguous on each side
+        constexpr bool src_b_fast = is_layout_right<typename Src::array_layout>;
+        constexpr bool dst_b_fast = is_layout_right<typename Dst::array_layout> != Swap;
+
+        const int tiles_a = (na + T - 1) / T, tiles_b = (nb + T - 1) / T;
+        const int per_plane = tiles_a * tiles_b;
+        const std::size_t bytes = scratch::shmem_size(T, T + 1); // +1 column: no bank conflicts on the strided side
+
+        Kokkos::parallel_for(
+            label, policy(per_plane * planes, Kokkos::AUTO).set_scratch_size(0, Kokkos::PerTeam(bytes)), KOKKOS_LAMBDA(const member &team) {
+                const int plane = team.league_rank() / per_plane;
+                const int r = team.league_rank() % per_plane;
+                const int group_first = r / (Group * tiles_b) * Group;
+                const int group_rows = tiles_a - group_first < Group ? tiles_a - group_first : Group;
+                const int in_group = r % (Group * tiles_b);
+                const int a0 = (group_first + in_group % group_rows) * T;
+                const int b0 = (in_group / group_rows) * T;
+                const int ta = na - a0 < T ? na - a0 : T;
+                const int tb = nb - b0 < T ? nb - b0 : T;
+                scratch tile(team.team_scratch(0), T, T + 1);
+
+                auto load = [&](int x, int y) {
+                    if constexpr (Src::rank == 3)
+                        tile(x, y) = src(a0 + x, plane, b0 + y);
+                    else
+                        tile(x, y) = src(a0 + x, b0 + y);
+                };
+                auto store = [&](int x, int y) {
+                    if constexpr (Dst::rank == 3)
+                        dst(a0 + x, plane, b0 + y) = tile(x, y);
+                    else if constexpr (Swap)
+                        dst(b0 + y, a0 + x) = tile(x, y);
+                    else
+                        dst(a0 + x, b0 + y) = tile(x, y);
+                };
+
+                if constexpr (src_b_fast)
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, ta), [&](int x) { Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, tb), [&](int y) { load(x, y); }); });
+                else
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, tb), [&](int y) { Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, ta), [&](int x) { load(x, y); }); });
+                team.team_barrier();
+                if constexpr (dst_b_fast)
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, ta), [&](int x) { Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, tb), [&](int y) { store(x, y); }); });
+                else
+                    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, tb), [&](int y) { Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, ta), [&](int x) { store(x, y); }); }); });
+    }
+
+    // dst(i, j[, k]) = src(i, j[, k]); a plain deep_copy when the layouts already agree
+    template <class Dst, class Src>
+    void convert(const Dst &dst, const Src &src)
+    {
+        for (unsigned r = 0; r < Src::rank; ++r)
+            if (dst.extent(r) != src.extent(r))
+                throw std::invalid_argument("relayout::convert: " + dst.label() + " and " + src.label() + " differ in extents");
+        if constexpr (std::is_same_v<typename Dst::array_layout, typename Src::array_layout>)
+            Kokkos::deep_copy(dst, src);
+        else
+            tiled<false>("relayout::convert", dst, src);
+    }
+
+    // dst(j, i) = src(i, j)
+    template <class Dst, class Src>
+    void transpose(const Dst &dst, const Src &src)
+    {
+        if (dst.extent(0) != src.extent(1) || dst.extent(1) != src.extent(0))
+            throw std::invalid_argument("relayout::transpose: " + dst.label() + " is not shaped as the transpose of " + src.label());
+        tiled<true>("relayout::transpose", dst, src);
+    }
+}
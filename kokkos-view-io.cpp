@@ -0,0 +1,174 @@
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include "benchmark.hpp"
+#include "kokkos-random.hpp"
+#include "kokkos-view-io.hpp"
+
+// Round trips of view_io::save / load / Mapping for both layouts, then load time of a large file
+// by bulk read against mmap
+// Usage: ./kokkos-view-io [--mb M] [--dir D] [--kokkos-num-threads=T] [--json file]
+//   --mb is the size of the benchmark matrix in MiB (default 1024, use 4096+ for multi-GB files)
+//   --dir is where the files go (default the system temp directory); they are removed at exit
+// Reading a file just written hits the page cache, and bench::Runner warms up and then takes at
+// least 3 samples, so these are warm-cache numbers: dropping the caches before a run
+// (echo 3 > /proc/sys/vm/drop_caches) only makes the untimed warmup read cold.
+
+namespace fs = std::filesystem;
+using HostExec = Kokkos::DefaultHostExecutionSpace;
+
+bool report(const std::string &what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+// Same extents and the same bytes; both Views are contiguous with the same layout
+template <class A, class B>
+bool same(const A &a, const B &b)
+{
+    for (unsigned r = 0; r < A::rank; ++r)
+        if (a.extent(r) != b.extent(r))
+            return false;
+    auto ha = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), a);
+    auto hb = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), b);
+    return std::memcmp(ha.data(), hb.data(), ha.span() * sizeof(typename A::non_const_value_type)) == 0;
+}
+
+template <class View>
+bool round_trip(const std::string &what, const View &v, const fs::path &file)
+{
+    view_io::save(file.string(), v);
+    const View loaded = view_io::load<View>(file.string());
+    view_io::Mapping<View> mapped(file.string());
+    bool ok = report(what + ": load", same(v, loaded) && loaded.label() == v.label());
+    ok &= report(what + ": mmap", same(v, mapped.view()));
+    return ok;
+}
+
+template <class View>
+bool rejects(const std::string &what, const fs::path &file)
+{
+    bool load_threw = false, map_threw = false;
+    try
+    {
+        view_io::load<View>(file.string());
+    }
+    catch (const std::runtime_error &)
+    {
+        load_threw = true;
+    }
+    try
+    {
+        view_io::Mapping<View> m(file.string());
+    }
+    catch (const std::runtime_error &)
+    {
+        map_threw = true;
+    }
+    return report(what, load_threw && map_threw);
+}
+
+template <class View>
+double sum(const View &v)
+{
+    const auto *data = v.data();
+    double total = 0;
+    Kokkos::parallel_reduce("sum_file", Kokkos::RangePolicy<HostExec>(0, v.span()), KOKKOS_LAMBDA(std::int64_t i, double &s) { s += data[i]; }, total);
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    std::int64_t mb = 1024;
+    fs::path dir = fs::temp_directory_path();
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--mb")
+            mb = std::atoll(argv[i + 1]);
+        else if (std::string(argv[i]) == "--dir")
+            dir = argv[i + 1];
+    }
+    dir /= "kokkos-view-io-" + std::to_string(::getpid());
+    fs::create_directories(dir);
+
+    random_fill::Filler<> random(2024);
+    std::cout << "\n=== Round trips ===\n";
+    bool ok = true;
+    {
+        // Extents that are not multiples of anything, so a layout mix-up cannot go unnoticed
+        Kokkos::View<double **, Kokkos::LayoutRight> right("right", 123, 77);
+        Kokkos::View<double **, Kokkos::LayoutLeft> left("left", 123, 77);
+        Kokkos::View<float ***, Kokkos::LayoutLeft> cube("cube", 5, 6, 7);
+        Kokkos::View<std::int64_t *> ids("ids", 1001);
+        random.normal(right, 0.0, 1.0);
+        random.normal(left, 0.0, 1.0);
+        Kokkos::parallel_for("fill_cube", Kokkos::MDRangePolicy<Kokkos::Rank<3>>({0, 0, 0}, {5, 6, 7}), KOKKOS_LAMBDA(int i, int j, int k) { cube(i, j, k) = 100.0f * i + 10.0f * j + k + 0.5f; });
+        random.integer(ids, -(std::int64_t(1) << 40), std::int64_t(1) << 40);
+
+        ok &= round_trip("double ** LayoutRight 123x77", right, dir / "right.kvio");
+        ok &= round_trip("double ** LayoutLeft 123x77", left, dir / "left.kvio");
+        ok &= round_trip("float *** LayoutLeft 5x6x7", cube, dir / "cube.kvio");
+        ok &= round_trip("int64 * 1001", ids, dir / "ids.kvio");
+
+        ok &= rejects<Kokkos::View<double **, Kokkos::LayoutLeft>>("LayoutRight file rejected as LayoutLeft", dir / "right.kvio");
+        ok &= rejects<Kokkos::View<float **, Kokkos::LayoutRight>>("double file rejected as float", dir / "right.kvio");
+        ok &= rejects<Kokkos::View<double *>>("rank 2 file rejected as rank 1", dir / "right.kvio");
+        fs::resize_file(dir / "left.kvio", fs::file_size(dir / "left.kvio") - 8);
+        ok &= rejects<Kokkos::View<double **, Kokkos::LayoutLeft>>("truncated file rejected", dir / "left.kvio");
+    }
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    {
+        const std::int64_t rows = static_cast<std::int64_t>(std::sqrt(double(mb) * (1 << 20) / sizeof(double)));
+        using Matrix = Kokkos::View<double **, Kokkos::LayoutLeft>;
+        Matrix A("checkpoint", rows, rows);
+        random.uniform(A, 0.0, 1.0);
+        const fs::path file = dir / "checkpoint.kvio";
+        const double bytes = double(A.span()) * sizeof(double);
+        const std::string size = " " + std::to_string(static_cast<std::int64_t>(bytes) >> 20) + " MiB";
+        view_io::save(file.string(), A);
+        const double expected = sum(A);
+
+        runner.run(
+            "save" + size, [&]()
+            { view_io::save(file.string(), A); },
+            bytes);
+        runner.run(
+            "load bulk read" + size, [&]()
+            { bench::DoNotOptimize(view_io::load<Matrix>(file.string())); },
+            bytes);
+        runner.run(
+            "map only" + size, [&]()
+            { view_io::Mapping<Matrix> m(file.string()); bench::DoNotOptimize(m.view().data()); });
+        // Mapping defers the reads to the first touch, so compare both with one pass over the data
+        runner.run(
+            "load bulk read + sum" + size, [&]()
+            { bench::DoNotOptimize(sum(view_io::load<Matrix>(file.string()))); },
+            bytes);
+        runner.run(
+            "map + sum" + size, [&]()
+            { view_io::Mapping<Matrix> m(file.string()); bench::DoNotOptimize(sum(m.view())); },
+            bytes);
+
+        view_io::Mapping<Matrix> mapped(file.string());
+        ok &= report("sum of the mapped checkpoint matches the original", sum(mapped.view()) == expected);
+    }
+
+    fs::remove_all(dir);
+    int status = runner.finish();
+    return ok ? status : 1;
+}
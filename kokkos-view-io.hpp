@@ -0,0 +1,254 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Binary checkpoint files for LayoutLeft / LayoutRight Views
+// A file is a fixed header followed by the raw data in the View's own layout:
+//   magic "KVIO", version, rank, layout, scalar type and size, 8 extents, label, data offset
+// The data starts on a 4096-byte boundary so it can be mapped directly.
+// - save(path, v): one fwrite of the host copy of v
+// - load<View>(path): one fread into the host mirror of a new managed View (no zero fill)
+// - Mapping<View>(path): mmap of the file wrapped as an unmanaged HostSpace View, no copy at all;
+//   pages are read on first touch and writes stay private to the process (MAP_PRIVATE)
+// The rank, layout and scalar type of the file must match the requested View type exactly.
+//
+//   view_io::save("A.kvio", A);
+//   auto B = view_io::load<Kokkos::View<double **, Kokkos::LayoutLeft>>("A.kvio");
+//   view_io::Mapping<Kokkos::View<double **, Kokkos::LayoutLeft>> m("A.kvio");   // m.view() lives as long as m
+namespace view_io
+{
+    inline constexpr char magic[4] = {'K', 'V', 'I', 'O'};
+    inline constexpr std::uint32_t version = 1;
+    inline constexpr std::uint64_t alignment = 4096;
+
+    enum class Scalar : std::uint32_t
+    {
+        int32 = 1,
+        int64,
+        uint32,
+        uint64,
+        float32,
+        float64
+    };
+
+    template <class T>
+    constexpr Scalar scalar_of()
+    {
+        if constexpr (std::is_same_v<T, float>)
+            return Scalar::float32;
+        else if constexpr (std::is_same_v<T, double>)
+            return Scalar::float64;
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4)
+            return Scalar::int32;
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 8)
+            return Scalar::int64;
+        else if constexpr (std::is_integral_v<T> && sizeof(T) == 4)
+            return Scalar::uint32;
+        else
+        {
+            static_assert(std::is_integral_v<T> && sizeof(T) == 8, "view_io: unsupported scalar type");
+            return Scalar::uint64;
+        }
+    }
+
+    template <class Layout>
+    constexpr std::uint32_t layout_of()
+    {
+        static_assert(std::is_same_v<Layout, Kokkos::LayoutRight> || std::is_same_v<Layout, Kokkos::LayoutLeft>,
+                      "view_io: only LayoutRight and LayoutLeft Views are contiguous");
+        return std::is_same_v<Layout, Kokkos::LayoutRight> ? 0 : 1;
+    }
+
+    struct Header
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t rank;
+        std::uint32_t layout; // 0 LayoutRight, 1 LayoutLeft
+        std::uint32_t scalar;
+        std::uint32_t scalar_size;
+        std::uint64_t extents[8];
+        std::uint64_t data_offset;
+        char label[128];
+
+        std::uint64_t count() const
+        {
+            std::uint64_t n = 1;
+            for (std::uint32_t r = 0; r < rank; ++r)
+                n *= extents[r];
+            return n;
+        }
+        std::uint64_t data_bytes() const { return count() * scalar_size; }
+    };
+
+    template <class View>
+    Header header_of(const View &v)
+    {
+        Header h{};
+        std::memcpy(h.magic, magic, sizeof(magic));
+        h.version = version;
+        h.rank = View::rank;
+        h.layout = layout_of<typename View::array_layout>();
+        h.scalar = static_cast<std::uint32_t>(scalar_of<typename View::non_const_value_type>());
+        h.scalar_size = sizeof(typename View::non_const_value_type);
+        for (std::uint32_t r = 0; r < h.rank; ++r)
+            h.extents[r] = v.extent(r);
+        h.data_offset = (sizeof(Header) + alignment - 1) / alignment * alignment;
+        std::strncpy(h.label, v.label().c_str(), sizeof(h.label) - 1);
+        return h;
+    }
+
+    // Throws unless the file header describes a View of type View
+    template <class View>
+    void check(const Header &h, const std::string &path)
+    {
+        if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.version != version)
+            throw std::runtime_error("view_io: " + path + " is not a version " + std::to_string(version) + " View file");
+        if (h.rank != View::rank)
+            throw std::runtime_error("view_io: " + path + " holds a rank " + std::to_string(h.rank) + " View, expected rank " + std::to_string(View::rank));
+        if (h.layout != layout_of<typename View::array_layout>())
+            throw std::runtime_error("view_io: " + path + " holds a " + (h.layout == 0 ? "LayoutRight" : "LayoutLeft") + " View");
+        if (h.scalar != static_cast<std::uint32_t>(scalar_of<typename View::non_const_value_type>()) ||
+            h.scalar_size != sizeof(typename View::non_const_value_type))
+            throw std::runtime_error("view_io: " + path + " holds another scalar type");
+    }
+
+    template <class View, std::size_t... R>
+    View make_view(typename View::pointer_type data, const Header &h, std::index_sequence<R...>)
+    {
+        return View(data, static_cast<std::size_t>(h.extents[R])...);
+    }
+
+    template <class View, std::size_t... R>
+    View make_view(const std::string &label, const Header &h, std::index_sequence<R...>)
+    {
+        return View(Kokkos::view_alloc(Kokkos::WithoutInitializing, label), static_cast<std::size_t>(h.extents[R])...);
+    }
+
+    inline Header read_header(std::FILE *f, const std::string &path)
+    {
+        Header h{};
+        if (std::fread(&h, sizeof(Header), 1, f) != 1)
+            throw std::runtime_error("view_io: cannot read the header of " + path);
+        h.label[sizeof(h.label) - 1] = '\0';
+        return h;
+    }
+
+    template <class View>
+    void save(const std::string &path, const View &v)
+    {
+        const Header h = header_of(v);
+        auto host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), v);
+        std::FILE *f = std::fopen(path.c_str(), "wb");
+        if (!f)
+            throw std::runtime_error("view_io: cannot open " + path + " for writing");
+        static const char zeros[alignment] = {};
+        bool ok = std::fwrite(&h, sizeof(Header), 1, f) == 1 &&
+                  std::fwrite(zeros, 1, h.data_offset - sizeof(Header), f) == h.data_offset - sizeof(Header) &&
+                  std::fwrite(host.data(), 1, h.data_bytes(), f) == h.data_bytes();
+        ok &= std::fclose(f) == 0;
+        if (!ok)
+            throw std::runtime_error("view_io: failed writing " + path);
+    }
+
+    // New managed View (in View's memory space) labeled as in the file
+    template <class View>
+    View load(const std::string &path)
+    {
+        std::FILE *f = std::fopen(path.c_str(), "rb");
+        if (!f)
+            throw std::runtime_error("view_io: cannot open " + path);
+        View v;
+        try
+        {
+            const Header h = read_header(f, path);
+            check<View>(h, path);
+            v = make_view<View>(std::string(h.label), h, std::make_index_sequence<View::rank>());
+            auto host = Kokkos::create_mirror_view(Kokkos::WithoutInitializing, v);
+            if (std::fseek(f, static_cast<long>(h.data_offset), SEEK_SET) != 0 ||
+                std::fread(host.data(), 1, h.data_bytes(), f) != h.data_bytes())
+                throw std::runtime_error("view_io: " + path + " is truncated");
+            Kokkos::deep_copy(v, host);
+        }
+        catch (...)
+        {
+            std::fclose(f);
+            throw;
+        }
+        std::fclose(f);
+        return v;
+    }
+
+    // Copy-on-write file mapping (MAP_PRIVATE) viewed as an unmanaged HostSpace View: the file is
+    // opened read-only and never changes, writes through the View copy the touched pages into
+    // memory private to the process. Unmapped by the destructor
+    template <class View>
+    class Mapping
+    {
+    public:
+        using view_type = Kokkos::View<typename View::data_type, typename View::array_layout, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>;
+
+    private:
+        void *address_ = nullptr;
+        std::size_t length_ = 0;
+        view_type view_;
+
+    public:
+        explicit Mapping(const std::string &path)
+        {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("view_io: cannot open " + path);
+            struct stat st;
+            Header h{};
+            const bool read_ok = ::fstat(fd, &st) == 0 && ::pread(fd, &h, sizeof(Header), 0) == static_cast<ssize_t>(sizeof(Header));
+            if (!read_ok)
+            {
+                ::close(fd);
+                throw std::runtime_error("view_io: cannot read the header of " + path);
+            }
+            try
+            {
+                check<View>(h, path);
+                if (static_cast<std::uint64_t>(st.st_size) < h.data_offset + h.data_bytes())
+                    throw std::runtime_error("view_io: " + path + " is truncated");
+            }
+            catch (...)
+            {
+                ::close(fd);
+                throw;
+            }
+            length_ = static_cast<std::size_t>(h.data_offset + h.data_bytes());
+            address_ = ::mmap(nullptr, length_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            ::close(fd); // the mapping keeps its own reference to the file
+            if (address_ == MAP_FAILED)
+                throw std::runtime_error("view_io: cannot map " + path);
+            ::madvise(address_, length_, MADV_SEQUENTIAL);
+            auto *data = reinterpret_cast<typename view_type::pointer_type>(static_cast<char *>(address_) + h.data_offset);
+            view_ = make_view<view_type>(data, h, std::make_index_sequence<View::rank>());
+        }
+
+        Mapping(const Mapping &) = delete;
+        Mapping &operator=(const Mapping &) = delete;
+
+        ~Mapping()
+        {
+            if (address_ && address_ != MAP_FAILED)
+                ::munmap(address_, length_);
+        }
+
+        const view_type &view() const { return this->view_; }
+    };
+}
@@ -1,33 +1,14 @@
 #include <Kokkos_Core.hpp>
+#include <cstdlib>
 #include <iostream>
 #include <chrono>
 #include <string>
 #include <thread>
 
-class TimerGuard
-{
-private:
-    std::string description_;
-    std::chrono::time_point<std::chrono::high_resolution_clock> start_;
-
-public:
-    explicit TimerGuard(const std::string &description)
-        : description_(description),
-          start_(std::chrono::high_resolution_clock::now())
-    {
-        std::cout << "[TIMER] Starting: " << description_ << '\n';
-    }
-
-    ~TimerGuard()
-    {
-        auto end_ = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = end_ - start_;
-        std::cout << "[TIMER]: " << description_ << " took " << elapsed.count() << " second \n";
-    }
-
-    TimerGuard(const TimerGuard &timer) = delete;
-    TimerGuard &operator=(const TimerGuard &timer) = delete;
-};
+#include "benchmark.hpp"
+#include "kokkos-stream.hpp"
+#include "perf-counters.hpp"
+#include "profiler.hpp"
 
 int main(int argc, char *argv[])
 {
@@ -118,14 +99,43 @@ int main(int argc, char *argv[])
         std::cout << host_view[i] << " ";
     std::cout << "\n";
 
-    // Part 5: Test Layout Experiments
+    // Part 5: Layout Bandwidth Suite
+    // Parallel copy/scale/add/triad for both layouts, index orders and Iterate directions,
+    // from L1-resident matrices to far beyond the last level cache, on 1, 2, 4, ... threads
+    // Options: --max-size N (largest N x N, default 4096), --csv file, and the bench::Runner ones
+    // (--filter "triad LayoutRight", --json file, --samples n, ...)
+    std::cout << "\n=== Layout Bandwidth Suite ===\n";
+    int max_size = 4096;
+    std::string csv_file;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--max-size")
+            max_size = std::atoi(argv[i + 1]);
+        else if (std::string(argv[i]) == "--csv")
+            csv_file = argv[i + 1];
+    }
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    stream::Suite<> suite(runner);
+    for (int threads : stream::Suite<>::thread_counts())
+        for (int n = 32; n <= max_size; n *= 2)
+            if (!suite.run(n, threads))
+                break; // no partition of that many threads, the other sizes would not get one either
+    if (!csv_file.empty())
+        suite.write_csv(csv_file);
+
+    // Reference: the serial layout tests with hardware counters
     const int N = 1000;
     Kokkos::View<double **, Kokkos::LayoutLeft> m_left("m_left", N, N);
     Kokkos::View<double **, Kokkos::LayoutRight> m_right("m_right", N, N);
-    std::cout << "\n=== Layout Experiment ===\n";
+    std::cout << "\n=== Serial Layout Reference ===\n";
+    // Each test also reports hardware counters (IPC, cache/TLB misses per kilo-instruction)
+    // The strided tests should show far more L1D, LLC and dTLB misses for the same instruction count
+    // CounterGuard comes first so the timer is innermost: the perf_event setup, read and report
+    // stay outside the reported time
 
     // Test 1: Row-major access on LayoutRight (should be fast)
     {
+        CounterGuard counters("LayoutRight with row-major access");
         TimerGuard timer("LayoutRight with row-major access");
         for (int i = 0; i < N; ++i)
         {
@@ -139,6 +149,7 @@ int main(int argc, char *argv[])
 
     // Test 2: Column-major access on LayoutRight (should be slow)
     {
+        CounterGuard counters("LayoutRight with column-major access");
         TimerGuard timer("LayoutRight with column-major access");
         for (int j = 0; j < N; ++j)
         {
@@ -152,6 +163,7 @@ int main(int argc, char *argv[])
 
     // Test 3: Row-major access on LayoutLeft (should be slow)
     {
+        CounterGuard counters("LayoutLeft with row-major access");
         TimerGuard timer("LayoutLeft with row-major access");
         for (int i = 0; i < N; ++i)
         {
@@ -165,6 +177,7 @@ int main(int argc, char *argv[])
 
     // Test 4: Column-major access on LayoutLeft (should be fast)
     {
+        CounterGuard counters("LayoutLeft with column-major access");
         TimerGuard timer("LayoutLeft with column-major access");
         for (int j = 0; j < N; ++j)
         {
@@ -176,5 +189,5 @@ int main(int argc, char *argv[])
         Kokkos::fence(); // Ensure completion of Kokkos APIs (if any) before mesuring TimeGuard
     }
 
-    return 0;
+    return runner.finish();
 }
\ No newline at end of file
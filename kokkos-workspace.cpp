@@ -0,0 +1,113 @@
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "benchmark.hpp"
+#include "kokkos-workspace.hpp"
+
+// Per-iteration time of a solver-like step that needs three temporaries of n doubles
+// (two written by one kernel, combined by a second, then reduced), with the temporaries
+// - allocated fresh every step and zero-filled (the default View constructor)
+// - allocated fresh every step WithoutInitializing
+// - leased from a workspace::Pool
+// Usage: ./kokkos-workspace [--kokkos-num-threads=T] [--json file]
+
+struct Temporaries
+{
+    Kokkos::View<double *> x, y, z;
+};
+
+// Every element of the temporaries is written before it is read
+double step(const Temporaries &t, std::int64_t n, int iteration)
+{
+    const auto x = t.x, y = t.y, z = t.z;
+    Kokkos::parallel_for("fill_x_y", n, KOKKOS_LAMBDA(std::int64_t i) {
+        x(i) = 0.5 * i + iteration;
+        y(i) = 1.0 / (i + 1); });
+    Kokkos::parallel_for("z_axpy", n, KOKKOS_LAMBDA(std::int64_t i) { z(i) = x(i) * y(i) + 2.0 * y(i); });
+    double sum = 0;
+    Kokkos::parallel_reduce("sum_z", n, KOKKOS_LAMBDA(std::int64_t i, double &s) { s += z(i); }, sum);
+    return sum;
+}
+
+double fresh_step(std::int64_t n, int iteration)
+{
+    Temporaries t{Kokkos::View<double *>("x", n), Kokkos::View<double *>("y", n), Kokkos::View<double *>("z", n)};
+    return step(t, n, iteration);
+}
+
+double uninitialized_step(std::int64_t n, int iteration)
+{
+    using Kokkos::view_alloc, Kokkos::WithoutInitializing;
+    Temporaries t{Kokkos::View<double *>(view_alloc(WithoutInitializing, "x"), n),
+                  Kokkos::View<double *>(view_alloc(WithoutInitializing, "y"), n),
+                  Kokkos::View<double *>(view_alloc(WithoutInitializing, "z"), n)};
+    return step(t, n, iteration);
+}
+
+double pooled_step(workspace::Pool<> &pool, std::int64_t n, int iteration)
+{
+    auto x = pool.get<double *>("x", n), y = pool.get<double *>("y", n), z = pool.get<double *>("z", n);
+    return step({x.view(), y.view(), z.view()}, n, iteration);
+}
+
+bool report(const std::string &what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    Kokkos::ScopeGuard guard(argc, argv);
+    std::cout << "Execution Space: " << typeid(Kokkos::DefaultExecutionSpace).name()
+              << ", concurrency " << Kokkos::DefaultExecutionSpace().concurrency() << "\n";
+
+    bool ok = true;
+    {
+        workspace::Pool<> pool;
+        const std::int64_t n = 100003;
+        bool same = true;
+        for (int it = 0; it < 5; ++it)
+            same &= pooled_step(pool, n, it) == fresh_step(n, it) && uninitialized_step(n, it) == fresh_step(n, it);
+        ok &= report("pooled and fresh temporaries give the same results", same);
+        workspace::Stats s = pool.stats();
+        ok &= report("5 steps allocate 3 buffers once (" + std::to_string(s.misses) + " misses, " + std::to_string(s.hits) + " hits)", s.misses == 3 && s.hits == 12);
+    }
+    {
+        // A reused buffer holds the previous user's data, zeroed() clears it; the layout and
+        // rank of the previous user do not matter, only the size in bytes
+        workspace::Pool<> pool;
+        {
+            auto dirty = pool.get<double *>("dirty", 300 * 200);
+            Kokkos::deep_copy(dirty.view(), 42.0);
+        }
+        auto m = pool.zeroed<double **, Kokkos::LayoutLeft>("matrix", 300, 200);
+        double total = 0;
+        const auto mv = m.view();
+        Kokkos::parallel_reduce("sum_m", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {300, 200}), KOKKOS_LAMBDA(int i, int j, double &t) { t += mv(i, j); }, total);
+        ok &= report("zeroed() LayoutLeft matrix on a reused rank 1 buffer is all zeros", total == 0.0 && pool.stats().hits == 1);
+        m.release();
+        ok &= report("released leases are cached, none leased", pool.stats().leased_bytes == 0);
+    }
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    workspace::Pool<> pool;
+    for (std::int64_t n : {std::int64_t(1) << 10, std::int64_t(1) << 16, std::int64_t(1) << 20, std::int64_t(1) << 24})
+    {
+        const std::string size = " n=" + std::to_string(n);
+        int iteration = 0;
+        runner.run("fresh Views (zero-filled)" + size, [&]()
+                   { bench::DoNotOptimize(fresh_step(n, ++iteration)); });
+        runner.run("fresh Views WithoutInitializing" + size, [&]()
+                   { bench::DoNotOptimize(uninitialized_step(n, ++iteration)); });
+        runner.run("workspace::Pool" + size, [&]()
+                   { bench::DoNotOptimize(pooled_step(pool, n, ++iteration)); });
+    }
+    const workspace::Stats s = pool.stats();
+    std::cout << "pool: " << s.misses << " allocations, " << s.hits << " reuses, " << (s.cached_bytes >> 20) << " MiB cached\n";
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// Pool of reusable work arrays for temporaries that are allocated every iteration
+// A fresh View costs an allocation (a system call for large sizes, page faults on first touch)
+// plus a zero-filling kernel, even when the next kernel overwrites every element. The pool keeps
+// released buffers and hands them out again as unmanaged Views of any data type and layout:
+// - get<DataType, Layout>(label, extents...): no initialization at all (new buffers are
+//   allocated WithoutInitializing, reused ones hold whatever the last user wrote)
+// - zeroed<DataType, Layout>(label, extents...): the same, followed by a fill with zeros
+// Buffers are keyed by their size in bytes: a request takes the smallest free buffer that is at
+// least as large and at most twice as large, so the layout or scalar type of the last user does
+// not matter. The returned Lease gives the buffer back to the pool when it goes out of scope; the
+// View it holds must not be used after that. The pool must be destroyed before Kokkos::finalize.
+//
+//   workspace::Pool<> pool;
+//   for (int step = 0; step < steps; ++step)
+//   {
+//       auto lease = pool.get<double *>("residual", n);
+//       auto r = lease.view();                           // unmanaged View<double *>
+//       Kokkos::parallel_for(n, KOKKOS_LAMBDA(int i) { r(i) = ...; });
+//   }                                                    // lease ends, buffer back in the pool
+namespace workspace
+{
+    struct Stats
+    {
+        std::uint64_t hits = 0;   // requests served from the pool
+        std::uint64_t misses = 0; // requests that allocated
+        std::size_t cached_bytes = 0;
+        std::size_t leased_bytes = 0;
+    };
+
+    template <class MemorySpace = Kokkos::DefaultExecutionSpace::memory_space>
+    class Pool
+    {
+    public:
+        using buffer_type = Kokkos::View<char *, MemorySpace>;
+
+        template <class DataType, class Layout>
+        using view_type = Kokkos::View<DataType, Layout, MemorySpace, Kokkos::MemoryUnmanaged>;
+
+        // Owns one pool buffer and the View over it; movable, not copyable
+        template <class View>
+        class Lease
+        {
+            Pool *pool_ = nullptr;
+            buffer_type buffer_;
+            View view_;
+
+        public:
+            Lease(Pool *pool, buffer_type buffer, View view) : pool_(pool), buffer_(std::move(buffer)), view_(std::move(view)) {}
+            Lease(Lease &&other) noexcept : pool_(std::exchange(other.pool_, nullptr)), buffer_(std::move(other.buffer_)), view_(std::move(other.view_)) {}
+            Lease &operator=(Lease &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    release();
+                    pool_ = std::exchange(other.pool_, nullptr);
+                    buffer_ = std::move(other.buffer_);
+                    view_ = std::move(other.view_);
+                }
+                return *this;
+            }
+            Lease(const Lease &) = delete;
+            Lease &operator=(const Lease &) = delete;
+            ~Lease() { release(); }
+
+            const View &view() const { return this->view_; }
+
+            void release()
+            {
+                if (pool_)
+                    std::exchange(pool_, nullptr)->give_back(std::move(buffer_));
+                view_ = View();
+            }
+        };
+
+    private:
+        std::multimap<std::size_t, buffer_type> free_; // by capacity in bytes
+        Stats stats_;
+        mutable std::mutex mutex_;
+
+    public:
+        Pool() = default;
+        Pool(const Pool &) = delete;
+        Pool &operator=(const Pool &) = delete;
+
+        template <class DataType, class Layout = Kokkos::LayoutRight, class... Extents>
+        Lease<view_type<DataType, Layout>> get(const std::string &label, Extents... extents)
+        {
+            using View = view_type<DataType, Layout>;
+            const std::size_t bytes = View::required_allocation_size(static_cast<std::size_t>(extents)...);
+            buffer_type buffer = acquire(label, bytes);
+            View view(reinterpret_cast<typename View::pointer_type>(buffer.data()), static_cast<std::size_t>(extents)...);
+            return Lease<View>(this, std::move(buffer), std::move(view));
+        }
+
+        template <class DataType, class Layout = Kokkos::LayoutRight, class... Extents>
+        Lease<view_type<DataType, Layout>> zeroed(const std::string &label, Extents... extents)
+        {
+            auto lease = get<DataType, Layout>(label, extents...);
+            Kokkos::deep_copy(lease.view(), typename view_type<DataType, Layout>::non_const_value_type());
+            return lease;
+        }
+
+        Stats stats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return stats_;
+        }
+
+        // Frees every cached buffer (leased ones are unaffected)
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.clear();
+            stats_.cached_bytes = 0;
+        }
+
+    private:
+        buffer_type acquire(const std::string &label, std::size_t bytes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = free_.lower_bound(bytes);
+                if (it != free_.end() && it->first <= 2 * bytes)
+                {
+                    buffer_type buffer = std::move(it->second);
+                    stats_.cached_bytes -= it->first;
+                    stats_.leased_bytes += it->first;
+                    ++stats_.hits;
+                    free_.erase(it);
+                    return buffer;
+                }
+                ++stats_.misses;
+                stats_.leased_bytes += bytes;
+            }
+            return buffer_type(Kokkos::view_alloc(Kokkos::WithoutInitializing, "workspace::" + label), bytes);
+        }
+
+        void give_back(buffer_type buffer)
+        {
+            const std::size_t capacity = buffer.extent(0);
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.leased_bytes -= capacity;
+            stats_.cached_bytes += capacity;
+            free_.emplace(capacity, std::move(buffer));
+        }
+    };
+}
@@ -1,8 +1,22 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <experimental/simd>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
 #include <optional>
+#include <random>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+namespace stdx = std::experimental;
+
 class Student
 {
 private:
@@ -49,7 +63,256 @@ std::optional<Student> find_best_student(const std::vector<Student> &students)
     return best;
 }
 
-int main()
+// Columnar (struct-of-arrays) student storage
+// Names live back to back in one string arena, averages in a 64-byte aligned double array
+// Queries return an index or a StudentView, never a copied Student
+struct StudentView
+{
+    std::size_t index;
+    std::string_view name;
+    double average;
+};
+
+class StudentTable
+{
+private:
+    static constexpr std::size_t alignment_ = 64;
+
+    struct AlignedFree
+    {
+        void operator()(double *p) const { std::free(p); }
+    };
+
+    std::string names_;                // name arena
+    std::vector<std::size_t> offsets_; // name i is names_[offsets_[i], offsets_[i + 1])
+    std::unique_ptr<double[], AlignedFree> averages_;
+    std::size_t size_;
+    std::size_t capacity_;
+
+    static double *allocate_averages(std::size_t n)
+    {
+        // aligned_alloc requires the size to be a multiple of the alignment
+        std::size_t bytes = (n * sizeof(double) + alignment_ - 1) / alignment_ * alignment_;
+        auto *p = static_cast<double *>(std::aligned_alloc(alignment_, bytes == 0 ? alignment_ : bytes));
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+public:
+    StudentTable() : names_(), offsets_{0}, averages_(nullptr), size_(0), capacity_(0) {}
+
+    void reserve(std::size_t n, std::size_t name_bytes = 0)
+    {
+        names_.reserve(name_bytes);
+        offsets_.reserve(n + 1);
+        if (n <= capacity_)
+            return;
+        std::unique_ptr<double[], AlignedFree> grown(allocate_averages(n));
+        if (size_ > 0)
+            std::memcpy(grown.get(), averages_.get(), size_ * sizeof(double));
+        averages_ = std::move(grown);
+        capacity_ = n;
+    }
+
+    void add(std::string_view name, double average)
+    {
+        if (size_ == capacity_)
+            reserve(capacity_ == 0 ? 16 : 2 * capacity_);
+        names_.append(name);
+        offsets_.push_back(names_.size());
+        averages_[size_++] = average;
+    }
+
+    std::size_t size() const { return this->size_; }
+    bool empty() const { return this->size_ == 0; }
+
+    // Accessors
+    std::string_view name(std::size_t i) const
+    {
+        return std::string_view(names_).substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+    double average(std::size_t i) const { return this->averages_[i]; }
+    const double *averages() const { return this->averages_.get(); }
+
+    StudentView operator[](std::size_t i) const { return {i, name(i), average(i)}; }
+};
+
+// Split [0, n) into one contiguous chunk per hardware thread and run fn(thread, begin, end)
+// Small inputs stay on the calling thread, spawning is not worth it below ~64k elements
+template <typename F>
+void parallel_chunks(std::size_t n, std::size_t n_threads, F &&fn)
+{
+    if (n_threads <= 1 || n < (std::size_t{1} << 16))
+    {
+        fn(std::size_t{0}, std::size_t{0}, n);
+        return;
+    }
+    std::vector<std::thread> pool;
+    pool.reserve(n_threads - 1);
+    std::size_t chunk = (n + n_threads - 1) / n_threads;
+    for (std::size_t t = 1; t < n_threads; ++t)
+    {
+        std::size_t begin = std::min(n, t * chunk);
+        std::size_t end = std::min(n, begin + chunk);
+        pool.emplace_back([&fn, t, begin, end]()
+                          { fn(t, begin, end); });
+    }
+    fn(std::size_t{0}, std::size_t{0}, std::min(n, chunk));
+    for (auto &th : pool)
+        th.join();
+}
+
+// Vectorized arg-max (or arg-min when Max == false) over a[begin, end)
+// Each SIMD lane tracks its own best value and index (indices held as doubles, exact below 2^53)
+// Ties resolve to the lowest index, matching find_best_student which keeps the first best
+template <bool Max>
+std::size_t arg_extremum(const double *a, std::size_t begin, std::size_t end)
+{
+    using simd_t = stdx::native_simd<double>;
+    constexpr std::size_t W = simd_t::size();
+    constexpr double init = Max ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+
+    if (begin >= end)
+        return end;
+
+    simd_t best_val(init);
+    simd_t best_idx(static_cast<double>(begin));
+    simd_t idx([begin](auto lane)
+               { return static_cast<double>(begin + lane); });
+    const simd_t step(static_cast<double>(W));
+
+    std::size_t i = begin;
+    for (; i + W <= end; i += W)
+    {
+        simd_t v(a + i, stdx::element_aligned);
+        auto better = Max ? (v > best_val) : (v < best_val);
+        stdx::where(better, best_val) = v;
+        stdx::where(better, best_idx) = idx;
+        idx += step;
+    }
+
+    double val = init;
+    std::size_t loc = begin;
+    bool found = false;
+    for (std::size_t lane = 0; lane < W; ++lane)
+    {
+        double lane_val = best_val[lane];
+        auto lane_loc = static_cast<std::size_t>(best_idx[lane]);
+        bool better = Max ? (lane_val > val) : (lane_val < val);
+        if (better || (lane_val == val && found && lane_loc < loc) || (!found && lane_val == val))
+        {
+            val = lane_val;
+            loc = lane_loc;
+            found = true;
+        }
+    }
+    for (; i < end; ++i)
+    {
+        if (Max ? (a[i] > val) : (a[i] < val))
+        {
+            val = a[i];
+            loc = i;
+        }
+    }
+    return loc;
+}
+
+template <bool Max>
+std::optional<std::size_t> parallel_arg_extremum(const StudentTable &table, std::size_t n_threads)
+{
+    if (table.empty())
+        return std::nullopt;
+
+    const double *a = table.averages();
+    std::vector<std::size_t> partial(std::max<std::size_t>(n_threads, 1), table.size());
+    parallel_chunks(table.size(), n_threads, [&](std::size_t t, std::size_t begin, std::size_t end)
+                    { partial[t] = arg_extremum<Max>(a, begin, end); });
+
+    // Chunks are ordered by thread id, so a strict comparison keeps the lowest index on ties
+    std::size_t loc = partial[0];
+    for (std::size_t t = 1; t < partial.size(); ++t)
+    {
+        if (partial[t] >= table.size())
+            continue;
+        if (Max ? (a[partial[t]] > a[loc]) : (a[partial[t]] < a[loc]))
+            loc = partial[t];
+    }
+    return loc;
+}
+
+std::size_t default_threads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::optional<StudentView> find_best_student(const StudentTable &table, std::size_t n_threads = default_threads())
+{
+    auto loc = parallel_arg_extremum<true>(table, n_threads);
+    if (!loc)
+        return std::nullopt;
+    return table[*loc];
+}
+
+std::optional<StudentView> find_worst_student(const StudentTable &table, std::size_t n_threads = default_threads())
+{
+    auto loc = parallel_arg_extremum<false>(table, n_threads);
+    if (!loc)
+        return std::nullopt;
+    return table[*loc];
+}
+
+// K best students, best first
+// Every thread keeps a min-heap of its K best (value, index) pairs, then the heaps are merged
+std::vector<StudentView> find_top_k_students(const StudentTable &table, std::size_t k, std::size_t n_threads = default_threads())
+{
+    using entry = std::pair<double, std::size_t>;
+    // Higher average first, lower index first on ties
+    auto better = [](const entry &x, const entry &y)
+    {
+        if (x.first != y.first)
+            return x.first > y.first;
+        return x.second < y.second;
+    };
+
+    k = std::min(k, table.size());
+    if (k == 0)
+        return {};
+
+    const double *a = table.averages();
+    std::vector<std::vector<entry>> heaps(std::max<std::size_t>(n_threads, 1));
+    parallel_chunks(table.size(), n_threads, [&](std::size_t t, std::size_t begin, std::size_t end)
+                    {
+        auto &heap = heaps[t];
+        heap.reserve(k);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (heap.size() < k)
+            {
+                heap.emplace_back(a[i], i);
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+            else if (a[i] > heap.front().first)
+            {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = {a[i], i};
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        } });
+
+    std::vector<entry> merged;
+    for (const auto &heap : heaps)
+        merged.insert(merged.end(), heap.begin(), heap.end());
+    std::partial_sort(merged.begin(), merged.begin() + k, merged.end(), better);
+
+    std::vector<StudentView> result;
+    result.reserve(k);
+    for (std::size_t i = 0; i < k; ++i)
+        result.push_back(table[merged[i].second]);
+    return result;
+}
+
+int main(int argc, char *argv[])
 {
     std::vector<Student> students = {
         {"Alice", 8.5},
@@ -97,5 +360,67 @@ int main()
         std::cout << "No students in list\n";
     }
 
+    // Test the columnar table on the same students
+    std::cout << "\n=== Test StudentTable ===\n";
+    StudentTable table;
+    for (const auto &stu : students)
+        table.add(stu.getName(), stu.getAvg());
+    if (auto b = find_best_student(table))
+        std::cout << "Best student: " << b->name << " (average: " << b->average << ")\n";
+    if (auto w = find_worst_student(table))
+        std::cout << "Worst student: " << w->name << " (average: " << w->average << ")\n";
+    std::cout << "Top 2: ";
+    for (const auto &s : find_top_k_students(table, 2))
+        std::cout << s.name << " (" << s.average << ") ";
+    std::cout << "\n";
+
+    // Benchmark: array-of-structs copy loop against the columnar arg-max
+    // Pass the number of students as first argument (default 10M)
+    std::cout << "\n=== Benchmark find_best_student ===\n";
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 10'000'000;
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> grade(0.0, 10.0);
+
+    std::vector<Student> big_list;
+    StudentTable big_table;
+    big_list.reserve(n);
+    big_table.reserve(n, n * 15);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::string name = "student_" + std::to_string(i);
+        double avg = grade(gen);
+        big_table.add(name, avg);
+        big_list.emplace_back(std::move(name), avg);
+    }
+
+    auto time_it = [](auto &&fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto r = fn();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return std::pair{r, elapsed.count()};
+    };
+
+    auto [aos, aos_ms] = time_it([&]()
+                                 { return find_best_student(big_list); });
+    auto [soa1, soa1_ms] = time_it([&]()
+                                   { return find_best_student(big_table, 1); });
+    auto [soa, soa_ms] = time_it([&]()
+                                 { return find_best_student(big_table); });
+    auto [top, top_ms] = time_it([&]()
+                                 { return find_top_k_students(big_table, 10); });
+
+    std::cout << n << " students, " << default_threads() << " threads\n";
+    if (!aos || !soa1 || !soa || top.empty())
+    {
+        std::cout << "No students, nothing to compare\n";
+        return 0;
+    }
+    std::cout << "vector<Student>          : " << aos->getName() << " " << aos->getAvg() << " in " << aos_ms << " ms\n";
+    std::cout << "StudentTable (1 thread)  : " << soa1->name << " " << soa1->average << " in " << soa1_ms << " ms\n";
+    std::cout << "StudentTable (threaded)  : " << soa->name << " " << soa->average << " in " << soa_ms << " ms\n";
+    std::cout << "StudentTable top-10      : " << top.front().name << " .. " << top.back().name << " in " << top_ms << " ms\n";
+    std::cout << "Same result: " << (aos->getName() == soa->name && soa->index == soa1->index) << "\n";
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Hardware performance counters for a scope, read through Linux perf_event_open
+// - Counts cycles, instructions, L1D/LLC read misses, dTLB read misses and branch misses
+// - Events are opened as one group so they are scheduled (and multiplexed) together,
+//   and values are scaled by time_enabled / time_running when the PMU is oversubscribed
+// - When no hardware PMU is exposed (VMs, containers, perf_event_paranoid > 2) it falls back
+//   to the software counters task-clock, page faults and context switches
+// - Only the calling thread is counted, user space only, so no privileges are needed
+namespace perf
+{
+    struct CounterSpec
+    {
+        const char *name;
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+
+    constexpr std::uint64_t cache_event(std::uint64_t cache, std::uint64_t op, std::uint64_t result)
+    {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    inline constexpr std::array<CounterSpec, 6> hardware_counters{{
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"L1D-misses", PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {"LLC-misses", PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {"dTLB-misses", PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    }};
+
+    inline constexpr std::array<CounterSpec, 3> software_counters{{
+        {"task-clock(ns)", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+        {"page-faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+        {"context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    }};
+
+    struct Reading
+    {
+        std::vector<std::string> names;
+        std::vector<double> values;
+
+        // Value of a counter, 0 when it was not available
+        double operator[](const std::string &name) const
+        {
+            for (std::size_t i = 0; i < names.size(); ++i)
+                if (names[i] == name)
+                    return values[i];
+            return 0.0;
+        }
+
+        bool has(const std::string &name) const
+        {
+            for (const auto &n : names)
+                if (n == name)
+                    return true;
+            return false;
+        }
+    };
+
+    class CounterGroup
+    {
+    private:
+        std::vector<int> fds_;
+        std::vector<std::string> names_;
+        bool hardware_ = false;
+
+        static int open_event(const CounterSpec &spec, int group_fd)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = spec.type;
+            attr.config = spec.config;
+            attr.disabled = group_fd == -1 ? 1 : 0; // the leader starts the whole group
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+        }
+
+        template <std::size_t N>
+        bool open_group(const std::array<CounterSpec, N> &specs)
+        {
+            for (const auto &spec : specs)
+            {
+                int fd = open_event(spec, fds_.empty() ? -1 : fds_.front());
+                if (fd == -1)
+                {
+                    // Without the leader nothing can be grouped, other counters are simply skipped
+                    if (fds_.empty())
+                        return false;
+                    continue;
+                }
+                fds_.push_back(fd);
+                names_.emplace_back(spec.name);
+            }
+            return true;
+        }
+
+    public:
+        CounterGroup()
+        {
+            hardware_ = open_group(hardware_counters);
+            if (!hardware_)
+                open_group(software_counters);
+        }
+
+        ~CounterGroup()
+        {
+            for (int fd : fds_)
+                close(fd);
+        }
+
+        CounterGroup(const CounterGroup &) = delete;
+        CounterGroup &operator=(const CounterGroup &) = delete;
+
+        bool available() const { return !this->fds_.empty(); }
+        bool hardware() const { return this->hardware_; }
+
+        void start()
+        {
+            if (fds_.empty())
+                return;
+            ioctl(fds_.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds_.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+
+        void stop()
+        {
+            if (!fds_.empty())
+                ioctl(fds_.front(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+
+        Reading read_values() const
+        {
+            Reading r{names_, std::vector<double>(names_.size(), 0.0)};
+            if (fds_.empty())
+                return r;
+            // Layout for PERF_FORMAT_GROUP: nr, time_enabled, time_running, value[nr]
+            std::vector<std::uint64_t> buf(3 + fds_.size());
+            if (::read(fds_.front(), buf.data(), buf.size() * sizeof(std::uint64_t)) <= 0)
+                return r;
+            double enabled = static_cast<double>(buf[1]);
+            double running = static_cast<double>(buf[2]);
+            double scale = running > 0 ? enabled / running : 0.0;
+            for (std::size_t i = 0; i < buf[0] && i < fds_.size(); ++i)
+                r.values[i] = static_cast<double>(buf[3 + i]) * scale;
+            return r;
+        }
+    };
+
+    inline void print_reading(std::ostream &os, const std::string &label, const Reading &r)
+    {
+        os << "[COUNTERS] " << label << ":";
+        for (std::size_t i = 0; i < r.names.size(); ++i)
+            os << " " << r.names[i] << "=" << static_cast<std::uint64_t>(r.values[i]);
+        os << "\n";
+
+        if (r.has("instructions") && r.has("cycles") && r["cycles"] > 0)
+        {
+            double kilo_instr = r["instructions"] / 1000.0;
+            char line[256];
+            std::snprintf(line, sizeof(line), "[COUNTERS] %s: IPC=%.2f", label.c_str(), r["instructions"] / r["cycles"]);
+            os << line;
+            // Miss rates as misses per thousand instructions (MPKI)
+            for (const char *name : {"L1D-misses", "LLC-misses", "dTLB-misses", "branch-misses"})
+            {
+                if (r.has(name) && kilo_instr > 0)
+                {
+                    std::snprintf(line, sizeof(line), " %s/kinstr=%.3f", name, r[name] / kilo_instr);
+                    os << line;
+                }
+            }
+            os << "\n";
+        }
+        else if (!r.names.empty())
+        {
+            os << "[COUNTERS] " << label << ": hardware counters unavailable, software counters only\n";
+        }
+        else
+        {
+            os << "[COUNTERS] " << label << ": perf_event_open unavailable\n";
+        }
+    }
+}
+
+// Scoped counter measurement in the same spirit as TimerGuard
+// Counters are opened outside the measured region and printed when the scope ends
+class CounterGuard
+{
+private:
+    std::string description_;
+    perf::CounterGroup group_;
+
+public:
+    explicit CounterGuard(const std::string &description) : description_(description), group_()
+    {
+        group_.start();
+    }
+
+    ~CounterGuard()
+    {
+        group_.stop();
+        perf::print_reading(std::cout, description_, group_.read_values());
+    }
+
+    CounterGuard(const CounterGuard &guard) = delete;
+    CounterGuard &operator=(const CounterGuard &guard) = delete;
+};
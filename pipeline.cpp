@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "benchmark.hpp"
+#include "pipeline.hpp"
+#include "thread-pool.hpp"
+
+// Sum of the squares greater than 30, as in main of algorithms.cpp, from L1-sized inputs to
+// far beyond the last level cache:
+// - multi-pass: copy (main squares in place), square_vector, filter_great into a new vector,
+//   sum_vector of it, on one thread and on parallel::default_pool()
+// - fused: pipes::pipeline(v).map(square).filter(gt(30)).reduce(sum), and .to_vector() when
+//   the filtered values are wanted, on one thread and on the pool
+// Usage: ./pipeline [--max-size N] [--json file] [--filter name] [--samples n]
+//   --max-size is the largest element count (default 64M doubles); GB/s counts one read of the input
+
+using namespace pipes;
+
+bool report(const std::string &what, bool ok)
+{
+    std::cout << (ok ? "[PASS] " : "[FAIL] ") << what << "\n";
+    return ok;
+}
+
+// Small integers: every sum is exact in double, whatever the order of the additions
+std::vector<double> make_values(std::size_t n)
+{
+    std::vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i)
+        v[i] = double(i % 16);
+    return v;
+}
+
+double multi_pass(const std::vector<double> &v)
+{
+    std::vector<double> w(v), filtered;
+    square_vector(w);
+    filter_great(w, filtered, 30.0);
+    return sum_vector(filtered);
+}
+
+double multi_pass(parallel::ThreadPool &pool, const std::vector<double> &v)
+{
+    std::vector<double> w(v), filtered;
+    square_vector(pool, w);
+    filter_great(pool, w, filtered, 30.0);
+    return sum_vector(pool, filtered);
+}
+
+bool verify()
+{
+    const std::vector<double> v = make_values(100003);
+    std::vector<double> squared(v), filtered{-1.0};
+    square_vector(squared);
+    filter_great(squared, filtered, 30.0);
+    parallel::ThreadPool pool(3);
+    bool ok = true;
+
+    const double expected = multi_pass(v);
+    ok &= report("fused reduce(sum) matches the multi-pass sequence",
+                 pipeline(v).map(square).filter(gt(30.0)).reduce(sum) == expected &&
+                     pipeline(pool, v).map(square).filter(gt(30.0)).reduce(sum) == expected &&
+                     pipeline(std::execution::par, v).map(square).filter(gt(30.0)).reduce(sum) == expected);
+
+    std::vector<double> one{-1.0}, many{-1.0};
+    pipeline(v).map(square).filter(gt(30.0)).collect(one);
+    pipeline(pool, v).map(square).filter(gt(30.0)).collect(many);
+    ok &= report("collect appends the values filter_great keeps", one == filtered && many == filtered);
+    ok &= report("count, min and max", pipeline(pool, v).map(square).filter(gt(30.0)).count() == filtered.size() - 1 &&
+                                           pipeline(pool, v).map(square).filter(gt(30.0)).reduce(pipes::min) == 36.0 &&
+                                           pipeline(v).map(square).reduce(pipes::max) == 225.0);
+
+    // A map after a filter only sees the kept values (no division by zero here)
+    const std::vector<int> ints{0, 3, 0, -4, 5, 0, 8};
+    const auto inverse = [](int x)
+    { return 120 / x; };
+    ok &= report("map after filter is not evaluated on dropped values",
+                 pipeline(ints).filter([](int x)
+                                       { return x != 0; })
+                         .map(inverse)
+                         .reduce(sum) == 40 - 30 + 24 + 15);
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t max_size = std::size_t(1) << 26;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string(argv[i]) == "--max-size")
+            max_size = std::strtoull(argv[i + 1], nullptr, 10);
+
+    std::cout << "=== Verification ===\n";
+    bool ok = verify();
+
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    parallel::ThreadPool &pool = parallel::default_pool();
+    std::cout << "\n=== Benchmarks, pool of " << pool.size() << " threads ===\n";
+    for (std::size_t n = std::size_t(1) << 12; n <= max_size; n <<= 2)
+    {
+        const std::vector<double> v = make_values(n);
+        const double bytes = double(n) * sizeof(double);
+        const std::string size = " n=" + std::to_string(n);
+        runner.run(
+            "copy of the input (part of multi-pass)" + size, [&]()
+            { std::vector<double> w(v); bench::DoNotOptimize(w.data()); },
+            bytes);
+        runner.run(
+            "multi-pass" + size, [&]()
+            { bench::DoNotOptimize(multi_pass(v)); },
+            bytes);
+        runner.run(
+            "multi-pass pool" + size, [&]()
+            { bench::DoNotOptimize(multi_pass(pool, v)); },
+            bytes);
+        runner.run(
+            "fused reduce" + size, [&]()
+            { bench::DoNotOptimize(pipeline(v).map(square).filter(gt(30.0)).reduce(sum)); },
+            bytes);
+        runner.run(
+            "fused reduce pool" + size, [&]()
+            { bench::DoNotOptimize(pipeline(pool, v).map(square).filter(gt(30.0)).reduce(sum)); },
+            bytes);
+        runner.run(
+            "fused to_vector" + size, [&]()
+            {
+                auto kept = pipeline(v).map(square).filter(gt(30.0)).to_vector();
+                bench::DoNotOptimize(kept.data()); },
+            bytes);
+        runner.run(
+            "fused to_vector pool" + size, [&]()
+            {
+                auto kept = pipeline(pool, v).map(square).filter(gt(30.0)).to_vector();
+                bench::DoNotOptimize(kept.data()); },
+            bytes);
+    }
+
+    int status = runner.finish();
+    return ok ? status : 1;
+}
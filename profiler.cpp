@@ -0,0 +1,86 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "profiler.hpp"
+
+// Per-scope overhead of PROFILE_SCOPE against TimerGuard
+// Build with -DPROFILER_DISABLE to check that the scopes compile out
+
+template <typename F>
+double ns_per_iteration(int iterations, F &&body)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        body();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+volatile int sink = 0;
+
+void work()
+{
+    sink = sink + 1;
+}
+
+void profiled_work()
+{
+    PROFILE_SCOPE("overhead/empty scope");
+    work();
+}
+
+void nested_profiled_work()
+{
+    PROFILE_SCOPE("overhead/outer");
+    {
+        PROFILE_SCOPE("overhead/inner");
+        work();
+    }
+}
+
+int main()
+{
+    const int iterations = 1'000'000;
+    clocks::init(); // not inside the first profiled loop below
+
+    double baseline = ns_per_iteration(iterations, work);
+    double profiled = ns_per_iteration(iterations, profiled_work);
+    double nested = ns_per_iteration(iterations, nested_profiled_work);
+
+    // TimerGuard prints twice per scope, send that to /dev/null so the terminal is not the bottleneck
+    double guarded;
+    {
+        std::ofstream null_stream("/dev/null");
+        auto *old = std::cout.rdbuf(null_stream.rdbuf());
+        guarded = ns_per_iteration(iterations / 10, []()
+                                   { TimerGuard timer("overhead/TimerGuard"); work(); });
+        std::cout.rdbuf(old);
+    }
+
+    std::cout << "=== Per-scope overhead (" << iterations << " iterations) ===\n";
+    std::cout << "no timer            : " << baseline << " ns\n";
+    std::cout << "PROFILE_SCOPE       : " << profiled - baseline << " ns\n";
+    std::cout << "2 nested scopes     : " << nested - baseline << " ns\n";
+    std::cout << "TimerGuard          : " << guarded - baseline << " ns\n";
+
+    // Scopes opened on several threads land in separate buffers, without interleaving
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([]()
+                             {
+            PROFILE_SCOPE("worker");
+            for (int i = 0; i < 1000; ++i)
+            {
+                PROFILE_SCOPE("task");
+                work();
+            } });
+    for (auto &th : threads)
+        th.join();
+
+    std::cout << "\n";
+    return 0;
+}
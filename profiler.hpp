@@ -0,0 +1,406 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "tsc-clock.hpp"
+
+// Hierarchical scope profiler
+// - Labels are compile-time strings: PROFILE_SCOPE("Outer operation")
+// - Every thread appends events to its own buffer, no lock is taken on the hot path
+// - Each event remembers its enclosing scope, so statistics are aggregated per call path
+// - Per-path count, total, min, max, mean, p50 and p99 are printed at program exit
+// - Set PROFILER_TRACE=trace.json (or call set_trace_file) to also write a Chrome Trace Event
+//   file at exit, loadable in chrome://tracing or https://ui.perfetto.dev
+// - Timestamps come from the invariant TSC when available (CLOCK_SOURCE=steady forces steady_clock)
+// - Define PROFILER_DISABLE to compile every PROFILE_SCOPE out
+// - A thread records at most PROFILER_MAX_EVENTS scopes (default 4M, 96 MiB of events); later
+//   scopes on that thread are counted as dropped and the report says how many
+#ifndef PROFILER_MAX_EVENTS
+#define PROFILER_MAX_EVENTS (std::uint32_t(1) << 22)
+#endif
+
+namespace profiler
+{
+    // Raw ticks of the selected clock source (see tsc-clock.hpp), converted to time only when reporting
+    inline std::int64_t now() { return clocks::now_ticks(); }
+
+    // String literal usable as a template argument
+    template <std::size_t N>
+    struct Label
+    {
+        char value[N];
+
+        constexpr Label(const char (&str)[N])
+        {
+            std::copy_n(str, N, value);
+        }
+
+        constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+    };
+
+    inline constexpr std::uint32_t no_parent = UINT32_MAX;
+    inline constexpr std::uint32_t not_recorded = UINT32_MAX; // slot of a dropped scope
+    inline constexpr std::uint32_t max_events = PROFILER_MAX_EVENTS;
+    static_assert(max_events > 0 && max_events < not_recorded, "PROFILER_MAX_EVENTS must fit a 32-bit slot");
+
+    struct Event
+    {
+        std::uint32_t label;
+        std::uint32_t parent; // slot of the enclosing scope in the same thread, or no_parent
+        std::int64_t start;   // clock ticks
+        std::int64_t end;
+    };
+
+    // Append-only event storage owned by one thread, up to max_events events
+    // Events live in fixed-size chunks so slots never move and appends never copy old events
+    class ThreadBuffer
+    {
+    private:
+        static constexpr std::size_t chunk_size_ = 4096;
+        std::vector<std::unique_ptr<std::array<Event, chunk_size_>>> chunks_;
+        std::uint32_t size_ = 0;
+        std::uint64_t dropped_ = 0;
+
+    public:
+        std::uint32_t current = no_parent; // innermost open scope
+        std::uint32_t thread_index = 0;
+
+        // Slot of the new event, not_recorded once the buffer is full
+        std::uint32_t open(std::uint32_t label, std::int64_t start)
+        {
+            if (size_ == max_events)
+            {
+                ++dropped_;
+                return not_recorded;
+            }
+            if (size_ % chunk_size_ == 0)
+                chunks_.emplace_back(new std::array<Event, chunk_size_>); // left uninitialized on purpose
+            std::uint32_t slot = size_++;
+            (*chunks_[slot / chunk_size_])[slot % chunk_size_] = {label, current, start, start};
+            current = slot;
+            return slot;
+        }
+
+        void close(std::uint32_t slot, std::int64_t end)
+        {
+            if (slot == not_recorded)
+                return;
+            Event &e = (*this)[slot];
+            e.end = end;
+            current = e.parent;
+        }
+
+        Event &operator[](std::uint32_t slot) { return (*chunks_[slot / chunk_size_])[slot % chunk_size_]; }
+        const Event &operator[](std::uint32_t slot) const { return (*chunks_[slot / chunk_size_])[slot % chunk_size_]; }
+        std::uint32_t size() const { return this->size_; }
+        std::uint64_t dropped() const { return this->dropped_; }
+    };
+
+    struct ScopeStats
+    {
+        std::size_t count;
+        double total_ns, min_ns, max_ns, mean_ns, p50_ns, p99_ns;
+    };
+
+    class Profiler
+    {
+    private:
+        std::mutex mutex_; // guards registration only, never taken while timing
+        std::vector<std::string> labels_;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+        bool report_at_exit_ = true;
+        std::string trace_file_;
+
+        Profiler()
+        {
+            clocks::init();
+            if (const char *path = std::getenv("PROFILER_TRACE"))
+                trace_file_ = path;
+        }
+
+        static double to_ns(std::int64_t ticks)
+        {
+            return clocks::to_ns(static_cast<double>(ticks));
+        }
+
+    public:
+        static Profiler &instance()
+        {
+            static Profiler p;
+            return p;
+        }
+
+        ~Profiler()
+        {
+            if (report_at_exit_)
+                report(std::cout);
+            if (!trace_file_.empty())
+                write_chrome_trace(trace_file_);
+        }
+
+        Profiler(const Profiler &) = delete;
+        Profiler &operator=(const Profiler &) = delete;
+
+        std::uint32_t intern(std::string_view label)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = std::find(labels_.begin(), labels_.end(), label);
+            if (it != labels_.end())
+                return static_cast<std::uint32_t>(it - labels_.begin());
+            labels_.emplace_back(label);
+            return static_cast<std::uint32_t>(labels_.size() - 1);
+        }
+
+        // Buffers are shared with the registry so events survive the thread that wrote them
+        std::shared_ptr<ThreadBuffer> register_thread()
+        {
+            auto buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer->thread_index = static_cast<std::uint32_t>(buffers_.size());
+            buffers_.push_back(buffer);
+            return buffer;
+        }
+
+        void set_report_at_exit(bool on) { this->report_at_exit_ = on; }
+        void set_trace_file(const std::string &path) { this->trace_file_ = path; }
+
+        // Scopes not recorded because a thread buffer was full
+        std::uint64_t dropped()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::uint64_t n = 0;
+            for (const auto &buffer : buffers_)
+                n += buffer->dropped();
+            return n;
+        }
+
+        // Statistics keyed by call path ("Outer operation/Inner operation")
+        // Only call once the timed threads are done (e.g. at exit)
+        std::map<std::string, ScopeStats> aggregate()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Call paths as (parent path, label) ids, shared by every thread; the strings are only
+            // built once per path at the end
+            std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> ids;
+            std::vector<std::pair<std::uint32_t, std::uint32_t>> nodes;
+            std::vector<std::vector<double>> node_samples;
+            for (const auto &buffer : buffers_)
+            {
+                std::vector<std::uint32_t> paths(buffer->size());
+                for (std::uint32_t slot = 0; slot < buffer->size(); ++slot)
+                {
+                    const Event &e = (*buffer)[slot];
+                    // A parent is always opened before its children, so its path is already known
+                    const std::pair<std::uint32_t, std::uint32_t> key{e.parent == no_parent ? no_parent : paths[e.parent], e.label};
+                    auto [it, added] = ids.try_emplace(key, static_cast<std::uint32_t>(nodes.size()));
+                    if (added)
+                    {
+                        nodes.push_back(key);
+                        node_samples.emplace_back();
+                    }
+                    paths[slot] = it->second;
+                    node_samples[it->second].push_back(to_ns(e.end - e.start));
+                }
+            }
+
+            // Parents get lower ids than their children; labels containing '/' may repeat a path
+            std::vector<std::string> names(nodes.size());
+            std::map<std::string, std::vector<double>> samples;
+            for (std::size_t id = 0; id < nodes.size(); ++id)
+            {
+                const auto [parent, label] = nodes[id];
+                names[id] = parent == no_parent ? labels_[label] : names[parent] + "/" + labels_[label];
+                std::vector<double> &v = samples[names[id]];
+                v.insert(v.end(), node_samples[id].begin(), node_samples[id].end());
+            }
+
+            std::map<std::string, ScopeStats> stats;
+            for (auto &[path, v] : samples)
+            {
+                std::sort(v.begin(), v.end());
+                double total = 0;
+                for (double x : v)
+                    total += x;
+                auto pct = [&v](double p)
+                { return v[static_cast<std::size_t>(p * static_cast<double>(v.size() - 1) + 0.5)]; };
+                stats[path] = {v.size(), total, v.front(), v.back(), total / static_cast<double>(v.size()), pct(0.50), pct(0.99)};
+            }
+            return stats;
+        }
+
+        void report(std::ostream &os)
+        {
+            auto stats = aggregate();
+            if (stats.empty())
+                return;
+            if (std::uint64_t n = dropped())
+                os << "[PROFILE] " << n << " scopes not recorded: a thread reached PROFILER_MAX_EVENTS ("
+                   << max_events << " events)\n";
+            char line[256];
+            std::snprintf(line, sizeof(line), "%-48s %10s %14s %12s %12s %12s %12s %12s\n",
+                          "[PROFILE] scope", "count", "total(ns)", "min(ns)", "max(ns)", "mean(ns)", "p50(ns)", "p99(ns)");
+            os << line;
+            for (const auto &[path, s] : stats)
+            {
+                std::snprintf(line, sizeof(line), "%-48s %10zu %14.0f %12.0f %12.0f %12.0f %12.0f %12.0f\n",
+                              path.c_str(), s.count, s.total_ns, s.min_ns, s.max_ns, s.mean_ns, s.p50_ns, s.p99_ns);
+                os << line;
+            }
+        }
+        // Chrome Trace Event format, one complete ("X") event per scope
+        // Timestamps are microseconds since the first recorded event, tid is the profiler thread index
+        // Nested scopes on the same thread are drawn as nested slices
+        void write_chrome_trace(const std::string &path)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::ofstream out(path);
+            if (!out)
+            {
+                std::cerr << "[PROFILE] cannot write trace to " << path << "\n";
+                return;
+            }
+
+            std::int64_t origin = INT64_MAX;
+            for (const auto &buffer : buffers_)
+                if (buffer->size() > 0)
+                    origin = std::min(origin, (*buffer)[0].start);
+
+            // JSON string escaping: quote, backslash and the control characters below 0x20
+            auto escape = [](const std::string &label)
+            {
+                std::string escaped;
+                for (char c : label)
+                {
+                    if (c == '"' || c == '\\')
+                    {
+                        escaped += '\\';
+                        escaped += c;
+                    }
+                    else if (c == '\n')
+                        escaped += "\\n";
+                    else if (c == '\t')
+                        escaped += "\\t";
+                    else if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char code[8];
+                        std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                        escaped += code;
+                    }
+                    else
+                        escaped += c;
+                }
+                return escaped;
+            };
+            auto to_us = [](std::int64_t ticks)
+            { return clocks::to_ns(static_cast<double>(ticks)) / 1000.0; };
+
+            char line[128];
+            bool first = true;
+            out << "{\"traceEvents\":[\n";
+            for (const auto &buffer : buffers_)
+            {
+                out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->thread_index
+                    << ",\"args\":{\"name\":\"thread " << buffer->thread_index << "\"}}";
+                first = false;
+                for (std::uint32_t slot = 0; slot < buffer->size(); ++slot)
+                {
+                    const Event &e = (*buffer)[slot];
+                    std::snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                                  buffer->thread_index, to_us(e.start - origin), to_us(e.end - e.start));
+                    out << ",\n{\"name\":\"" << escape(labels_[e.label]) << line;
+                }
+            }
+            out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        }
+    };
+
+    inline ThreadBuffer &thread_buffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer = Profiler::instance().register_thread();
+        return *buffer;
+    }
+
+    // One interned id per label, resolved once per call site
+    template <Label L>
+    std::uint32_t label_id()
+    {
+        static const std::uint32_t id = Profiler::instance().intern(L.view());
+        return id;
+    }
+
+    template <Label L>
+    class Scope
+    {
+    private:
+        ThreadBuffer &buffer_;
+        std::uint32_t slot_;
+
+    public:
+        Scope() : buffer_(thread_buffer()), slot_(buffer_.open(label_id<L>(), now())) {}
+
+        ~Scope()
+        {
+            buffer_.close(slot_, now());
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+}
+
+// Simple scoped timer, prints on construction and destruction
+// Convenient for examples, too heavy for hot paths (use PROFILE_SCOPE below instead)
+// The scope is also recorded by the profiler, so it shows up in the statistics and the trace
+class TimerGuard
+{
+private:
+    std::string description_;
+    profiler::ThreadBuffer &buffer_;
+    std::int64_t start_;
+    std::uint32_t slot_; // not_recorded when the thread buffer is full
+
+public:
+    explicit TimerGuard(const std::string &description)
+        : description_(description),
+          buffer_(profiler::thread_buffer()),
+          start_(profiler::now()),
+          slot_(buffer_.open(profiler::Profiler::instance().intern(description_), start_))
+    {
+        std::cout << "[TIMER] Starting: " << description_ << '\n';
+    }
+
+    ~TimerGuard()
+    {
+        const std::int64_t end = profiler::now();
+        buffer_.close(slot_, end);
+        double elapsed = clocks::to_ns(static_cast<double>(end - start_)) * 1e-9;
+        std::cout << "[TIMER]: " << description_ << " took " << elapsed << " second \n";
+    }
+
+    TimerGuard(const TimerGuard &timer) = delete;
+    TimerGuard &operator=(const TimerGuard &timer) = delete;
+};
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef PROFILER_DISABLE
+#define PROFILE_SCOPE(label)
+#else
+#define PROFILE_SCOPE(label) ::profiler::Scope<label> PROFILER_CONCAT(profile_scope_, __LINE__)
+#endif
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads for fork-join loops over contiguous ranges
+// The calling thread takes part 0 and the workers the others, so a pool of size() == 1 runs
+// everything on the caller without any synchronization. One job runs at a time; a job started
+// from inside a job (nested parallelism) runs serially on the thread that started it.
+// An exception thrown by any part is rethrown by run() once every part has finished.
+//
+//   parallel::ThreadPool pool(4);
+//   pool.for_ranges(v.size(), [&](unsigned part, std::size_t begin, std::size_t end) { ... });
+namespace parallel
+{
+    class ThreadPool
+    {
+    private:
+        std::vector<std::thread> workers_;
+        std::mutex submit_; // one job at a time
+        std::mutex mutex_;  // guards the job state below
+        std::condition_variable start_, done_;
+        std::function<void(unsigned)> job_;
+        unsigned parts_ = 0;
+        unsigned pending_ = 0;
+        std::uint64_t generation_ = 0;
+        std::exception_ptr error_;
+        bool stop_ = false;
+        inline static thread_local bool inside_job_ = false;
+
+        void work(unsigned part)
+        {
+            std::uint64_t seen = 0;
+            inside_job_ = true;
+            for (;;)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&]()
+                            { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+                if (part >= parts_)
+                    continue;
+                lock.unlock();
+                std::exception_ptr error;
+                try
+                {
+                    job_(part);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                if (error && !error_)
+                    error_ = error;
+                if (--pending_ == 0)
+                    done_.notify_one();
+            }
+        }
+
+    public:
+        explicit ThreadPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            for (unsigned part = 1; part < std::max(1u, threads); ++part)
+                workers_.emplace_back([this, part]()
+                                      { work(part); });
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            start_.notify_all();
+            for (std::thread &t : workers_)
+                t.join();
+        }
+
+        // Threads taking part in a job, the caller included
+        unsigned size() const { return static_cast<unsigned>(workers_.size()) + 1; }
+
+        // Calls body(part) once for every part in [0, parts), parts <= size()
+        void run(unsigned parts, const std::function<void(unsigned)> &body)
+        {
+            parts = std::min(parts, size());
+            if (parts <= 1 || inside_job_)
+            {
+                for (unsigned part = 0; part < parts; ++part)
+                    body(part);
+                return;
+            }
+            std::lock_guard<std::mutex> submit(submit_);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                job_ = body;
+                parts_ = parts;
+                pending_ = parts - 1;
+                error_ = nullptr;
+                ++generation_;
+            }
+            start_.notify_all();
+
+            std::exception_ptr error;
+            inside_job_ = true;
+            try
+            {
+                body(0);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            inside_job_ = false;
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [&]()
+                       { return pending_ == 0; });
+            job_ = nullptr;
+            if (!error)
+                error = error_;
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        // Parts a range of n elements is split into: one per thread, at least grain elements each
+        unsigned parts_for(std::size_t n, std::size_t grain) const
+        {
+            return static_cast<unsigned>(std::clamp<std::size_t>(n / std::max<std::size_t>(grain, 1), 1, size()));
+        }
+
+        // Calls body(part, begin, end) over parts_for(n, grain) contiguous pieces of [0, n); the
+        // split only depends on n, grain and size(), so consecutive passes see the same pieces
+        template <class F>
+        void for_ranges(std::size_t n, F &&body, std::size_t grain = std::size_t(1) << 14)
+        {
+            const unsigned parts = parts_for(n, grain);
+            run(parts, [&](unsigned part)
+                { body(part, n * part / parts, n * (part + 1) / parts); });
+        }
+    };
+
+    // Pool with one thread per hardware thread, used when no pool is given
+    inline ThreadPool &default_pool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+}
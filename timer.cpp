@@ -3,30 +3,7 @@
 #include <string>
 #include <thread>
 
-class TimerGuard
-{
-private:
-    std::string description_;
-    std::chrono::time_point<std::chrono::high_resolution_clock> start_;
-
-public:
-    explicit TimerGuard(const std::string &description)
-        : description_(description),
-          start_(std::chrono::high_resolution_clock::now())
-    {
-        std::cout << "[TIMER] Starting: " << description_ << '\n';
-    }
-
-    ~TimerGuard()
-    {
-        auto end_ = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = end_ - start_;
-        std::cout << "[TIMER]: " << description_ << " took " << elapsed.count() << " second \n";
-    }
-
-    TimerGuard(const TimerGuard &timer) = delete;
-    TimerGuard &operator=(const TimerGuard &timer) = delete;
-};
+#include "profiler.hpp"
 
 void expensive_operation()
 {
@@ -38,8 +15,10 @@ void another_operation()
     std::this_thread::sleep_for(std::chrono::milliseconds(250));
 }
 
+// Run with PROFILER_TRACE=timer-trace.json to get a timeline for chrome://tracing or Perfetto
 int main()
 {
+    clocks::init();
     std::cout << "=== Test 1: Single timer ===\n";
     {
         TimerGuard timer("Test operation");
@@ -56,7 +35,18 @@ int main()
         expensive_operation();
     } // Outer timer ends here
 
-    std::cout << "\n=== Test 3: Early return ===\n";
+    std::cout << "\n=== Test 3: Profiled nested scopes (statistics printed at exit) ===\n";
+    for (int i = 0; i < 3; ++i)
+    {
+        PROFILE_SCOPE("Outer operation");
+        {
+            PROFILE_SCOPE("Inner operation");
+            another_operation();
+        }
+        expensive_operation();
+    }
+
+    std::cout << "\n=== Test 4: Early return ===\n";
     {
         TimerGuard timer("Operation with early return");
         expensive_operation();
@@ -0,0 +1,62 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "benchmark.hpp"
+#include "tsc-clock.hpp"
+
+// Checks the calibrated clock against steady_clock over long scopes, then measures per-read cost
+// Returns non-zero when the drift exceeds the tolerance
+// Usage: ./tsc-clock [--samples n] [--json file]  (CLOCK_SOURCE=steady to test the fallback)
+int main(int argc, char *argv[])
+{
+    clocks::init();
+    std::cout << "Clock source: " << clocks::source_name()
+              << " (" << 1.0 / clocks::calibration().ns_per_tick << " ticks/ns)\n";
+
+    // Test: drift against steady_clock, scopes of 0.5 s, 1 s and 2 s
+    // 100 ppm tolerance: the calibration window is 50 ms, so a few microseconds of read skew
+    // at its endpoints already amount to tens of ppm
+    std::cout << "\n=== Drift against steady_clock ===\n";
+    const double tolerance_ppm = 100.0;
+    bool passed = true;
+    for (int ms : {500, 1000, 2000})
+    {
+        std::int64_t s0 = clocks::steady_ns();
+        std::int64_t t0 = clocks::now_ticks();
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        std::int64_t t1 = clocks::now_ticks();
+        std::int64_t s1 = clocks::steady_ns();
+
+        double steady = static_cast<double>(s1 - s0);
+        double timed = clocks::to_ns(static_cast<double>(t1 - t0));
+        double drift_ppm = (timed - steady) / steady * 1e6;
+        bool ok = std::abs(drift_ppm) < tolerance_ppm;
+        passed = passed && ok;
+        std::cout << ms << " ms scope: steady " << steady << " ns, clock " << timed << " ns, drift "
+                  << drift_ppm << " ppm " << (ok ? "OK" : "FAIL") << "\n";
+    }
+
+    // Benchmark: cost of one read
+    std::cout << "\n=== Per-read cost ===\n";
+    bench::Runner runner(bench::Options::parse(argc, argv));
+    runner.run("steady_clock::now", []()
+               { auto t = std::chrono::steady_clock::now(); bench::DoNotOptimize(t); });
+    runner.run("high_resolution_clock::now", []()
+               { auto t = std::chrono::high_resolution_clock::now(); bench::DoNotOptimize(t); });
+    runner.run("clocks::now_ticks (selected source)", []()
+               { auto t = clocks::now_ticks(); bench::DoNotOptimize(t); });
+#ifdef TSC_CLOCK_X86
+    runner.run("rdtsc (unfenced)", []()
+               { auto t = __rdtsc(); bench::DoNotOptimize(t); });
+    runner.run("lfence; rdtsc; lfence", []()
+               { auto t = clocks::rdtsc_ordered(); bench::DoNotOptimize(t); });
+    runner.run("rdtscp; lfence", []()
+               { auto t = clocks::rdtscp_ordered(); bench::DoNotOptimize(t); });
+#endif
+
+    int status = runner.finish();
+    std::cout << "\nDrift test " << (passed ? "passed" : "FAILED") << "\n";
+    return passed ? status : 1;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define TSC_CLOCK_X86 1
+#endif
+
+// Clock source for the scope timers
+// - tsc: invariant time-stamp counter read with rdtsc, fenced so the read is not reordered
+//   with the timed code, calibrated once against std::chrono::steady_clock
+// - steady: std::chrono::steady_clock (clock_gettime through the vDSO on Linux)
+// The TSC is used when the CPU reports an invariant TSC (constant rate, keeps ticking in deep
+// C-states), otherwise timers fall back to steady_clock. CLOCK_SOURCE=steady forces the fallback.
+// Timers store raw ticks, conversion to nanoseconds only happens when reporting.
+namespace clocks
+{
+    enum class Source
+    {
+        steady,
+        tsc
+    };
+
+    struct Calibration
+    {
+        Source source;
+        double ns_per_tick;
+    };
+
+    // CPUID leaf 0x80000007, EDX bit 8: invariant TSC
+    inline bool invariant_tsc()
+    {
+#ifdef TSC_CLOCK_X86
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+            return false;
+        __cpuid(0x80000007, eax, ebx, ecx, edx);
+        return (edx >> 8) & 1;
+#else
+        return false;
+#endif
+    }
+
+    inline std::int64_t steady_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+#ifdef TSC_CLOCK_X86
+    // lfence before: earlier instructions have completed; lfence after: later ones have not started
+    inline std::uint64_t rdtsc_ordered()
+    {
+        _mm_lfence();
+        std::uint64_t t = __rdtsc();
+        _mm_lfence();
+        return t;
+    }
+
+    // rdtscp waits for earlier instructions itself, the lfence keeps later ones behind it
+    inline std::uint64_t rdtscp_ordered()
+    {
+        unsigned int aux;
+        std::uint64_t t = __rdtscp(&aux);
+        _mm_lfence();
+        return t;
+    }
+#endif
+
+    // Ratio of steady_clock nanoseconds to TSC ticks over a short interval
+    // Each endpoint takes the tightest of several (steady, tsc) pairs to reduce read skew
+    inline double calibrate_tsc(std::chrono::milliseconds interval = std::chrono::milliseconds(50))
+    {
+#ifdef TSC_CLOCK_X86
+        auto sample = [](std::int64_t &ns, std::uint64_t &ticks)
+        {
+            std::uint64_t best_gap = UINT64_MAX;
+            for (int i = 0; i < 16; ++i)
+            {
+                std::uint64_t t0 = rdtsc_ordered();
+                std::int64_t s = steady_ns();
+                std::uint64_t t1 = rdtsc_ordered();
+                if (t1 - t0 < best_gap)
+                {
+                    best_gap = t1 - t0;
+                    ns = s;
+                    ticks = t0 + (t1 - t0) / 2;
+                }
+            }
+        };
+        std::int64_t ns0 = 0, ns1 = 0;
+        std::uint64_t tick0 = 0, tick1 = 0;
+        sample(ns0, tick0);
+        std::this_thread::sleep_for(interval);
+        sample(ns1, tick1);
+        return static_cast<double>(ns1 - ns0) / static_cast<double>(tick1 - tick0);
+#else
+        (void)interval;
+        return 1.0;
+#endif
+    }
+
+    inline Calibration calibrate()
+    {
+        const char *forced = std::getenv("CLOCK_SOURCE");
+        bool want_tsc = !(forced && std::strcmp(forced, "steady") == 0);
+        if (want_tsc && invariant_tsc())
+            return {Source::tsc, calibrate_tsc()};
+        return {Source::steady, 1.0};
+    }
+
+    // Calibrated once, on first use
+    inline const Calibration &calibration()
+    {
+        static const Calibration c = calibrate();
+        return c;
+    }
+
+    // Calibrates now: the first use otherwise sleeps for the 50 ms calibration interval, which
+    // lands inside whatever is being timed around it. Call at startup, before any timed region.
+    inline void init()
+    {
+        calibration();
+    }
+
+    inline std::int64_t now_ticks()
+    {
+#ifdef TSC_CLOCK_X86
+        if (calibration().source == Source::tsc)
+            return static_cast<std::int64_t>(rdtsc_ordered());
+#endif
+        return steady_ns();
+    }
+
+    inline double to_ns(double ticks)
+    {
+        return ticks * calibration().ns_per_tick;
+    }
+
+    inline const char *source_name()
+    {
+        return calibration().source == Source::tsc ? "invariant TSC" : "steady_clock";
+    }
+}